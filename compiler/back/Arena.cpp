@@ -0,0 +1,60 @@
+#include "Arena.h"
+
+#include <cstdint>
+#include <cstdlib>
+
+Arena::Arena() : current(nullptr), remaining(0), used(0), reserved(0)
+{
+}
+
+Arena::~Arena()
+{
+	for (int i = finalizers.size() - 1; i >= 0; i--)
+	{
+		finalizers[i].second(finalizers[i].first);
+	}
+	for (auto &chunk : chunks)
+	{
+		free(chunk);
+	}
+}
+
+void *Arena::allocate(size_t size, size_t align)
+{
+	size_t padding = (align - (uintptr_t)current % align) % align;
+	if (current == nullptr || padding + size > remaining)
+	{
+		// malloc aligne sur max_align_t : le début d'un bloc convient à tous les objets de l'IR
+		size_t length = size > chunkSize ? size : chunkSize;
+		char *chunk = (char *)malloc(length);
+		if (chunk == nullptr)
+		{
+			throw bad_alloc();
+		}
+		chunks.push_back(chunk);
+		reserved += length;
+		current = chunk;
+		remaining = length;
+		padding = 0;
+	}
+	void *object = current + padding;
+	current += padding + size;
+	remaining -= padding + size;
+	used += size;
+	return object;
+}
+
+size_t Arena::get_used()
+{
+	return used;
+}
+
+size_t Arena::get_reserved()
+{
+	return reserved;
+}
+
+int Arena::get_nb_chunks()
+{
+	return chunks.size();
+}
@@ -0,0 +1,61 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/** Allocateur par incrément (bump allocator) : les objets de l'IR sont rangés les uns à la suite des
+	autres dans de grands blocs, et ne sont jamais libérés un par un.
+
+	Allouer revient à avancer un pointeur dans le bloc courant ; un nouveau bloc est pris quand il
+	est plein (un objet plus grand qu'un bloc a le sien). À la destruction de l'arène, les
+	destructeurs des objets qui en ont un (vector, string...) sont appelés dans l'ordre inverse des
+	allocations, puis chaque bloc est rendu d'un coup.
+
+	Une arène de compilation (voir main) possède les CFG, et chaque CFG a sa propre arène pour ses
+	blocs de base, ses instructions et ses symboles : les passes d'une fonction n'allouent que dans
+	celle de sa fonction.
+*/
+class Arena
+{
+public:
+	Arena();
+	~Arena();
+	Arena(const Arena &) = delete;
+	Arena &operator=(const Arena &) = delete;
+
+	void *allocate(size_t size, size_t align);
+
+	/** Construit un T dans l'arène ; il vit jusqu'à la destruction de l'arène */
+	template <class T, class... Args>
+	T *make(Args &&...args)
+	{
+		T *object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		if (!is_trivially_destructible<T>::value)
+		{
+			finalizers.push_back({object, [](void *p) { static_cast<T *>(p)->~T(); }});
+		}
+		return object;
+	}
+
+	size_t get_used();	   /**< octets attribués aux objets */
+	size_t get_reserved(); /**< octets des blocs pris au système : rien n'étant rendu avant la fin, c'est le pic */
+	int get_nb_chunks();
+
+	static const size_t chunkSize = 64 * 1024;
+
+private:
+	vector<char *> chunks;
+	char *current;	  /**< prochain octet libre du bloc courant */
+	size_t remaining; /**< octets libres dans le bloc courant */
+	size_t used;
+	size_t reserved;
+	vector<pair<void *, void (*)(void *)>> finalizers; /**< objets à détruire, dans l'ordre des allocations */
+};
+
+#endif
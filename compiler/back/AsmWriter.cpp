@@ -0,0 +1,61 @@
+#include "AsmWriter.h"
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+AsmWriter::AsmWriter(size_t capacity)
+{
+	buffer.reserve(capacity);
+}
+
+void AsmWriter::put(char c)
+{
+	buffer.push_back(c);
+}
+
+void AsmWriter::put(const string &s)
+{
+	buffer.insert(buffer.end(), s.begin(), s.end());
+}
+
+void AsmWriter::put(const char *s, size_t length)
+{
+	buffer.insert(buffer.end(), s, s + length);
+}
+
+bool AsmWriter::flush(int fd)
+{
+	// write peut n'écrire qu'une partie du tampon (tube plein, signal) : on reprend où il s'est arrêté
+	size_t written = 0;
+	while (written < buffer.size())
+	{
+		ssize_t n = write(fd, buffer.data() + written, buffer.size() - written);
+		if (n < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			return false;
+		}
+		written += n;
+	}
+	clear();
+	return true;
+}
+
+const char *AsmWriter::data()
+{
+	return buffer.data();
+}
+
+size_t AsmWriter::size()
+{
+	return buffer.size();
+}
+
+void AsmWriter::clear()
+{
+	buffer.clear();
+}
@@ -0,0 +1,38 @@
+#ifndef ASM_WRITER_H
+#define ASM_WRITER_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/** Tampon de sortie de l'assembleur.
+
+	Le code d'une fonction est d'abord ajouté au tampon, sans passer par un ostream ni vider la
+	sortie à chaque ligne, puis flush() l'envoie avec un seul appel système write. Le tampon est
+	vidé mais garde sa capacité : il est réutilisé pour la fonction suivante.
+*/
+class AsmWriter
+{
+public:
+	AsmWriter(size_t capacity = initialCapacity);
+
+	void put(char c);
+	void put(const string &s);
+	void put(const char *s, size_t length);
+
+	/** Écrit tout le tampon sur le descripteur fd et le vide ; faux si l'écriture échoue */
+	bool flush(int fd);
+
+	/** Contenu du tampon, pour une sortie qui n'est pas un descripteur */
+	const char *data();
+	size_t size();
+	void clear();
+
+	static const size_t initialCapacity = 1 << 16;
+
+private:
+	vector<char> buffer;
+};
+
+#endif
@@ -0,0 +1,215 @@
+#include "DataFlow.h"
+
+#include <algorithm>
+
+BitVector::BitVector(int size, bool value) : nbBits(size), words((size + 63) / 64, value ? ~(uint64_t)0 : 0)
+{
+	// Les bits au-delà de size restent à 0 pour que l'égalité compare les mots directement
+	if (value && size % 64 != 0)
+	{
+		words.back() = ((uint64_t)1 << (size % 64)) - 1;
+	}
+}
+
+bool BitVector::union_with(const BitVector &other)
+{
+	bool changed = false;
+	for (int w = 0; w < words.size(); w++)
+	{
+		uint64_t word = words[w] | other.words[w];
+		changed = changed || word != words[w];
+		words[w] = word;
+	}
+	return changed;
+}
+
+bool BitVector::intersect_with(const BitVector &other)
+{
+	bool changed = false;
+	for (int w = 0; w < words.size(); w++)
+	{
+		uint64_t word = words[w] & other.words[w];
+		changed = changed || word != words[w];
+		words[w] = word;
+	}
+	return changed;
+}
+
+void BitVector::subtract(const BitVector &other)
+{
+	for (int w = 0; w < words.size(); w++)
+	{
+		words[w] &= ~other.words[w];
+	}
+}
+
+bool BitVector::operator==(const BitVector &other) const
+{
+	return nbBits == other.nbBits && words == other.words;
+}
+
+bool BitVector::operator!=(const BitVector &other) const
+{
+	return !(*this == other);
+}
+
+FlowGraph::FlowGraph(CFG *cfg) : entry(-1)
+{
+	for (auto &bb : cfg->get_bbs())
+	{
+		if (bb->label != "prologue" && bb->label != "epilogue")
+		{
+			if (bb->label == cfg->label)
+			{
+				entry = blocks.size();
+			}
+			blockIndex[bb] = blocks.size();
+			blocks.push_back(bb);
+		}
+	}
+
+	int nbBlocks = blocks.size();
+	preds.assign(nbBlocks, vector<int>());
+	succs.assign(nbBlocks, vector<int>());
+	isExit.assign(nbBlocks, false);
+	for (int b = 0; b < nbBlocks; b++)
+	{
+		for (BasicBlock *next : {blocks[b]->exit_true, blocks[b]->exit_false})
+		{
+			if (next == nullptr)
+			{
+				continue;
+			}
+			auto found = blockIndex.find(next);
+			if (found == blockIndex.end())
+			{
+				isExit[b] = true;
+			}
+			else if (find(succs[b].begin(), succs[b].end(), found->second) == succs[b].end())
+			{
+				succs[b].push_back(found->second);
+				preds[found->second].push_back(b);
+			}
+		}
+		isExit[b] = isExit[b] || blocks[b]->exit_true == nullptr;
+	}
+
+	// Parcours en profondeur itératif depuis l'entrée, puis les blocs restants dans l'ordre d'émission
+	vector<bool> visited(nbBlocks, false);
+	vector<int> postorder;
+	if (entry != -1)
+	{
+		vector<pair<int, int>> stack = {{entry, 0}};
+		visited[entry] = true;
+		while (!stack.empty())
+		{
+			int b = stack.back().first;
+			int next = stack.back().second++;
+			if (next >= succs[b].size())
+			{
+				postorder.push_back(b);
+				stack.pop_back();
+			}
+			else if (!visited[succs[b][next]])
+			{
+				visited[succs[b][next]] = true;
+				stack.push_back({succs[b][next], 0});
+			}
+		}
+	}
+	rpo.assign(postorder.rbegin(), postorder.rend());
+	for (int b = 0; b < nbBlocks; b++)
+	{
+		if (!visited[b])
+		{
+			rpo.push_back(b);
+		}
+	}
+}
+
+DataFlowAnalysis::DataFlowAnalysis(CFG *cfg, int nbBits, Direction direction, Meet meet) : graph(cfg), nbBits(nbBits), direction(direction), meet(meet)
+{
+}
+
+BitVector DataFlowAnalysis::boundary()
+{
+	return BitVector(nbBits, false);
+}
+
+void DataFlowAnalysis::solve()
+{
+	int nbBlocks = graph.blocks.size();
+	// Valeur de départ : le neutre de la rencontre (rien pour l'union, tout pour l'intersection)
+	bool top = meet == meet_intersection;
+	in.assign(nbBlocks, BitVector(nbBits, top));
+	out.assign(nbBlocks, BitVector(nbBits, top));
+
+	vector<int> order = graph.rpo;
+	if (direction == backward)
+	{
+		reverse(order.begin(), order.end());
+	}
+	BitVector bound = boundary();
+	vector<bool> pending(nbBlocks, true);
+	int nbPending = nbBlocks;
+	BitVector result;
+	while (nbPending > 0)
+	{
+		for (int b : order)
+		{
+			if (!pending[b])
+			{
+				continue;
+			}
+			pending[b] = false;
+			nbPending--;
+
+			vector<int> &sources = direction == forward ? graph.preds[b] : graph.succs[b];
+			vector<int> &targets = direction == forward ? graph.succs[b] : graph.preds[b];
+			vector<BitVector> &before = direction == forward ? in : out;
+			vector<BitVector> &after = direction == forward ? out : in;
+			bool atBoundary = direction == forward ? b == graph.entry : graph.isExit[b];
+
+			BitVector &input = before[b];
+			input = atBoundary ? bound : BitVector(nbBits, top);
+			for (int s : sources)
+			{
+				if (meet == meet_union)
+				{
+					input.union_with(after[s]);
+				}
+				else
+				{
+					input.intersect_with(after[s]);
+				}
+			}
+			result = BitVector(nbBits, false);
+			transfer(b, input, result);
+			if (result != after[b])
+			{
+				after[b] = result;
+				for (int t : targets)
+				{
+					if (!pending[t])
+					{
+						pending[t] = true;
+						nbPending++;
+					}
+				}
+			}
+		}
+	}
+}
+
+GenKillAnalysis::GenKillAnalysis(CFG *cfg, int nbBits, Direction direction, Meet meet) : DataFlowAnalysis(cfg, nbBits, direction, meet)
+{
+	gen.assign(graph.blocks.size(), BitVector(nbBits, false));
+	kill.assign(graph.blocks.size(), BitVector(nbBits, false));
+}
+
+void GenKillAnalysis::transfer(int block, const BitVector &input, BitVector &output)
+{
+	output = input;
+	output.subtract(kill[block]);
+	output.union_with(gen[block]);
+}
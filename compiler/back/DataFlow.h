@@ -0,0 +1,136 @@
+#ifndef DATAFLOW_H
+#define DATAFLOW_H
+
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "IR.h"
+
+using namespace std;
+
+/** Ensemble dense de bits, indexé par le numéro des symboles (ou des définitions) d'un CFG */
+class BitVector
+{
+public:
+	BitVector(int size = 0, bool value = false);
+
+	bool operator[](int i) const
+	{
+		return (words[i >> 6] >> (i & 63)) & 1;
+	}
+	void set(int i)
+	{
+		words[i >> 6] |= (uint64_t)1 << (i & 63);
+	}
+	void reset(int i)
+	{
+		words[i >> 6] &= ~((uint64_t)1 << (i & 63));
+	}
+	int size() const
+	{
+		return nbBits;
+	}
+
+	/** Les opérations ensemblistes renvoient vrai si l'ensemble a changé */
+	bool union_with(const BitVector &other);
+	bool intersect_with(const BitVector &other);
+	void subtract(const BitVector &other);
+	bool operator==(const BitVector &other) const;
+	bool operator!=(const BitVector &other) const;
+
+	/** Appelle f(i) pour chaque bit à 1, dans l'ordre croissant */
+	template <class F>
+	void for_each(F f) const
+	{
+		for (int w = 0; w < words.size(); w++)
+		{
+			uint64_t word = words[w];
+			while (word != 0)
+			{
+				f(w * 64 + __builtin_ctzll(word));
+				word &= word - 1;
+			}
+		}
+	}
+
+private:
+	int nbBits;
+	vector<uint64_t> words;
+};
+
+/** Prédécesseurs et successeurs des blocs d'un CFG.
+
+	Les blocs sont numérotés dans l'ordre d'émission de CFG::gen_asmX86, sans prologue ni épilogue.
+	rpo donne l'ordre de parcours des analyses : blocs atteignables en ordre postfixe inverse,
+	puis les blocs jamais atteints.
+*/
+class FlowGraph
+{
+public:
+	FlowGraph(CFG *cfg);
+
+	vector<BasicBlock *> blocks;
+	unordered_map<BasicBlock *, int> blockIndex;
+	vector<vector<int>> preds, succs;
+	vector<int> rpo;
+	vector<bool> isExit; /**< le bloc mène à l'épilogue */
+	int entry;			 /**< -1 si la fonction n'a pas de bloc d'entrée */
+};
+
+/** Solveur générique d'analyses de flot de données sur des vecteurs de bits.
+
+	Une analyse choisit son sens de parcours, son opérateur de rencontre (union pour « sur un
+	chemin », intersection pour « sur tous les chemins »), la valeur aux bornes de la fonction et
+	la fonction de transfert d'un bloc. solve() calcule le point fixe avec une liste de travail
+	parcourue en ordre postfixe inverse (ou postfixe en arrière) : un bloc n'est recalculé que si
+	l'un de ses voisins a changé.
+
+	in[b] est la valeur au début du bloc b et out[b] à sa fin, quel que soit le sens.
+*/
+class DataFlowAnalysis
+{
+public:
+	enum Direction
+	{
+		forward,
+		backward
+	};
+	enum Meet
+	{
+		meet_union,
+		meet_intersection
+	};
+
+	DataFlowAnalysis(CFG *cfg, int nbBits, Direction direction, Meet meet);
+	virtual ~DataFlowAnalysis() {}
+
+	void solve();
+
+	FlowGraph graph;
+	vector<BitVector> in, out;
+
+protected:
+	/** Valeur à l'entrée de la fonction (en avant) ou à sa sortie (en arrière) */
+	virtual BitVector boundary();
+	/** Calcule output (out en avant, in en arrière) à partir de input pour le bloc */
+	virtual void transfer(int block, const BitVector &input, BitVector &output) = 0;
+
+	int nbBits;
+	Direction direction;
+	Meet meet;
+};
+
+/** Analyse dont le transfert s'écrit output = gen U (input - kill) */
+class GenKillAnalysis : public DataFlowAnalysis
+{
+public:
+	GenKillAnalysis(CFG *cfg, int nbBits, Direction direction, Meet meet);
+
+protected:
+	void transfer(int block, const BitVector &input, BitVector &output) override;
+
+	vector<BitVector> gen, kill;
+};
+
+#endif
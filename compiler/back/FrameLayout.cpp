@@ -0,0 +1,40 @@
+#include "FrameLayout.h"
+
+#include <algorithm>
+
+FrameLayout::FrameLayout(CFG *cfg) : cfg(cfg)
+{
+}
+
+void FrameLayout::run()
+{
+	// Un tail_call quitte le cadre avant de sauter : il ne compte pas comme un appel
+	bool leaf = true;
+	int outgoing = 0;
+	for (auto &bb : cfg->get_bbs())
+	{
+		for (auto &instr : bb->instrs)
+		{
+			if (instr->op == IRInstr::call)
+			{
+				leaf = false;
+				outgoing = max(outgoing, 8 * ((int)instr->params.size() - 2 - 6));
+			}
+		}
+	}
+	int saved = 8 * cfg->get_callee_saved_registers().size();
+	int locals = cfg->get_frame_size();
+
+	if (leaf && locals == 0)
+	{
+		cfg->set_frame_layout(false, 0, saved + 8);
+		return;
+	}
+	int stackAdjust = (locals + 7) / 8 * 8 + outgoing;
+	// À l'entrée, %rsp + 8 est aligné sur 16 ; s'y ajoutent les pushq et le subq
+	if (!leaf && (8 + saved + 8 + stackAdjust) % 16 != 0)
+	{
+		stackAdjust += 8;
+	}
+	cfg->set_frame_layout(true, stackAdjust, saved + 16);
+}
@@ -0,0 +1,30 @@
+#ifndef FRAME_LAYOUT_H
+#define FRAME_LAYOUT_H
+
+#include "IR.h"
+
+using namespace std;
+
+/** Disposition du cadre de pile d'une fonction, après l'attribution des cases mémoire.
+
+	De l'adresse de retour vers le bas : les registres callee-saved, puis (si la fonction a un
+	pointeur de cadre) %rbp, les cases -N(%rbp) et la zone des arguments sortants, où un call place
+	ses arguments à partir du septième (8 * (i - 6)(%rsp), ABI System V). La taille réservée par
+	subq est arrondie pour que %rsp soit aligné sur 16 octets à chaque call.
+
+	Une fonction feuille (sans call) dont toutes les variables sont en registres n'a pas de cadre :
+	ni pushq %rbp ni subq. Les cases mémoire restent toujours adressées en -N(%rbp), aux mêmes
+	adresses que gcc -O0 : une variable lue sans initialisation y trouve la même valeur.
+	Les paramètres à partir du septième sont lus au-dessus de l'adresse de retour.
+*/
+class FrameLayout
+{
+public:
+	FrameLayout(CFG *cfg);
+	void run();
+
+private:
+	CFG *cfg;
+};
+
+#endif
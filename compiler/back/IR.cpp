@@ -1,10 +1,23 @@
 #include "IR.h"
+#include "Liveness.h"
+#include "RegisterAllocator.h"
+#include "StackSlotAllocator.h"
+#include "FrameLayout.h"
+#include "InstructionSelector.h"
+#include "MachineCode.h"
+#include "Peephole.h"
 
-CFG::CFG()
+#include <algorithm>
+
+CFG::CFG(Interner *interner) : interner(interner)
 {
-    symbolTable = unordered_map<int, unordered_map<string, infosSymbole *>*>();
     variablesInMemory = 0;
-    nbTmp = 0;
+    frameSize = 0;
+    framePointer = true;
+    stackAdjust = 0;
+    incomingArgsOffset = 16;
+    estimatedCost = 0;
+    selector = nullptr;
 }
 
 void CFG::add_bb(BasicBlock *bb)
@@ -12,161 +25,293 @@ void CFG::add_bb(BasicBlock *bb)
     bbs.push_back(bb);
 }
 
-void CFG::gen_asmX86(ostream &o)
+BasicBlock *CFG::create_bb(string label, int scope)
 {
-    if(this->errors.size() != 0){
-        for(auto& error: errors){
-            cerr << error <<endl;
-        }
-        exit(1);
-    } 
-    // On pourrait rajouter ici la nuance entre error et warning (liste de warning incluse dans le CFG)
-    else {
-        for (int i = 0; i < bbs.size(); i++)
-        {
-            if (bbs[i]->label != "prologue" && bbs[i]->label !="epilogue")
-            {
-                o << "\n.globl " << bbs[i]->label << endl
-                  << bbs[i]->label << ":" << endl;
-                if (i == 1)
-                {
-                    gen_asmX86_prologue(o);
-                }
-                bbs[i]->gen_asmX86(o);
-            }
-        }
-    }
+    return arena.make<BasicBlock>(this, label, scope);
 }
 
-string CFG::IR_reg_to_asm(string reg)
+IRInstr *CFG::create_instr(BasicBlock *bb, IRInstr::Operation op, const string &type, vector<IROperand> params, int scope)
 {
-    return string();
+    return arena.make<IRInstr>(bb, op, type, move(params), scope);
 }
 
-void CFG::gen_asmX86_prologue(ostream &o)
+Arena *CFG::get_arena()
 {
-    o <<"	pushq %rbp\n"
-		"	movq %rsp, %rbp\n";
+    return &arena;
 }
 
-void CFG::gen_asmX86_epilogue(ostream &o)
+const string *CFG::intern(const string &s)
 {
-    o <<         "	popq %rbp\n"
-				 " 	ret\n";
+    return interner->get(s);
 }
 
-void CFG::add_to_symbol_table(int scopeLevel, string name, string type, bool initialized, bool isTmp)
+void CFG::check_errors()
 {
-    this->variablesInMemory++;
-    this->symbolTable[scopeLevel]->insert(pair<string, infosSymbole*>(name, new infosSymbole(type, initialized, isTmp, variablesInMemory * 4)));
+    if(report_errors(cerr)){
+        exit(1);
+    }
 }
 
-bool CFG::already_defined_in_scope_symbol_table(int scopeLevel, string id){
-    bool alreadyDefined = false;
-    if (this->symbolTable[scopeLevel]->find(id) != this->symbolTable[scopeLevel]->end())
-    {
-         alreadyDefined = true;
+bool CFG::report_errors(ostream &o)
+{
+    for(auto& error: errors){
+        o << error <<endl;
     }
-    return alreadyDefined;
+    return errors.size() != 0;
 }
 
-int CFG::already_defined_in_another_accessible_scope(int scopeLevel, string id){
-    int alreadyDefined = 0;
-    while(scopeLevel>1) {
-        scopeLevel = scopeLevelRelationship[scopeLevel];
-        if(already_defined_in_scope_symbol_table(scopeLevel, id)){
-            alreadyDefined = scopeLevel;
+void CFG::gen_asmX86(AsmWriter &o)
+{
+    check_errors();
+    // On pourrait rajouter ici la nuance entre error et warning (liste de warning incluse dans le CFG)
+    {
+        // Les temporaires constants deviennent des immédiates et les conditions fusionnées avec leur saut
+        // restent dans les drapeaux : ils n'ont besoin d'aucun emplacement
+        InstructionSelector instructionSelector(this);
+        instructionSelector.prepare();
+        selector = &instructionSelector;
+
+        // Allocation des registres avant l'émission : les opérandes deviennent des registres ou des cases mémoire
+        Liveness liveness(this);
+        liveness.run();
+        RegisterAllocator allocator(this, &liveness);
+        allocator.run();
+        // Les variables restées en mémoire partagent leurs cases quand leurs durées de vie sont disjointes
+        StackSlotAllocator slots(this, &liveness);
+        slots.run();
+        FrameLayout frame(this);
+        frame.run();
+
+        vector<BasicBlock *> emitted;
+        for (auto &bb : bbs)
+        {
+            if (bb->label != "prologue" && bb->label != "epilogue")
+            {
+                emitted.push_back(bb);
+            }
+        }
+        MachineCode code;
+        for (int i = 0; i < emitted.size(); i++)
+        {
+            // Seul le point d'entrée est exporté : les autres blocs ont des étiquettes locales
+            if (i == 0)
+            {
+                code.add_directive(".globl", label);
+                code.add_label(label);
+                gen_asmX86_prologue(code);
+            }
+            else
+            {
+                code.add_label(asm_label(emitted[i]));
+            }
+            emitted[i]->gen_asmX86(code, i + 1 < emitted.size() ? emitted[i + 1] : nullptr);
         }
+        selector = nullptr;
+
+        // Le code est réécrit par le peephole avant d'être écrit
+        Peephole peephole(&code);
+        peephole.run();
+        peepholeStats = peephole.get_stats();
+        estimatedCost = InstructionSelector::cost(code.instrs);
+        code.write(o);
     }
-    return alreadyDefined;
-};
-
-string CFG::create_new_tempvar(int scopeLevel, string t)
-{
-    this->nbTmp++;
-    string varname = "!" + t + to_string(nbTmp);
-    this->add_to_symbol_table(scopeLevel, varname,"int", true, true);
-    return varname;
 }
 
-void CFG::create_symbol_table_scope(int scope_level) {
-    if(symbolTable.find(scope_level) == symbolTable.end()){
-        symbolTable.insert(pair<int, unordered_map<string, infosSymbole*>*>(scope_level, new unordered_map<string, infosSymbole*>()));
+string CFG::asm_label(BasicBlock *bb)
+{
+    if (bb->label == label)
+    {
+        return label;
     }
+    // Les noms de blocs se répètent d'une fonction à l'autre (then3...) : le nom de la fonction les distingue
+    return ".L" + label + "." + bb->label;
 }
 
-int CFG::get_var_index(int scopeLevel, string id)
+string CFG::IR_reg_to_asm(int id)
 {
-    int index = -1;
-    // On commence par vérifier si la variable existe dans la table des symboles associée à la portée
-    if (this->symbolTable[scopeLevel]->find(id) != this->symbolTable[scopeLevel]->end())
+    if (varConstants.count(id))
     {
-        index = this->symbolTable[scopeLevel]->find(id)->second->getOffset();
-        return index;
+        return "$" + to_string(varConstants[id]);
     }
-    else
+    if (varRegisters[id] != "")
     {
-        // Sinon, on cherche dans les tables dont les symboles sont accessibles depuis la portée
-        while (scopeLevel > 1)
-        {
-            scopeLevel = scopeLevelRelationship[scopeLevel];
-            if (this->symbolTable[scopeLevel]->find(id) != this->symbolTable[scopeLevel]->end())
-            {
-                index = this->symbolTable[scopeLevel]->find(id)->second->getOffset();
-                return index;
-            }
-        }
+        return varRegisters[id];
     }
-    return index;
+    return "-" + to_string(symbols[id]->getOffset()) + "(%rbp)";
 }
 
-bool CFG::get_var_is_initialized(int scopeLevel, string id)
+void CFG::gen_asmX86_prologue(MachineCode &code)
 {
-    bool initialized = false;
-    // On commence par vérifier si la variable existe dans la table des symboles associée à la portée
-    if (this->symbolTable[scopeLevel]->find(id) != this->symbolTable[scopeLevel]->end())
+    // Les registres callee-saved sont sauvegardés avant %rbp : les variables restant en mémoire
+    // gardent ainsi leurs adresses -N(%rbp) sous le pointeur de base
+    for (auto &reg : calleeSavedRegisters)
     {
-         initialized = this->symbolTable[scopeLevel]->find(id)->second->isInitialized();
+        code.add_instr("pushq", {reg});
     }
-    else
+    if (!framePointer)
     {
-         // Sinon, on cherche dans les tables dont les symboles sont accessibles depuis la portée
-         while (scopeLevel > 1)
-         {
-            scopeLevel = scopeLevelRelationship[scopeLevel];
-            if (this->symbolTable[scopeLevel]->find(id) != this->symbolTable[scopeLevel]->end())
-            {
-                initialized = this->symbolTable[scopeLevel]->find(id)->second->isInitialized();
-                return initialized;
-            }
-         }
+        return;
+    }
+    code.add_instr("pushq", {"%rbp"});
+    code.add_instr("movq", {"%rsp", "%rbp"});
+    if (stackAdjust > 0)
+    {
+        code.add_instr("subq", {"$" + to_string(stackAdjust), "%rsp"});
     }
-    return initialized;
 }
 
-void CFG::set_var_is_initialized(int scopeLevel, string id)
+void CFG::gen_asmX86_epilogue(MachineCode &code, string tailCallee)
 {
-    // On commence par vérifier si la variable existe dans la table des symboles associée à la portée
-    if (this->symbolTable[scopeLevel]->find(id) != this->symbolTable[scopeLevel]->end())
+    if (framePointer)
     {
-         this->symbolTable[scopeLevel]->find(id)->second->setInitialized(true);
+        if (stackAdjust > 0)
+        {
+            code.add_instr("addq", {"$" + to_string(stackAdjust), "%rsp"});
+        }
+        code.add_instr("popq", {"%rbp"});
     }
-    else
+    for (auto reg = calleeSavedRegisters.rbegin(); reg != calleeSavedRegisters.rend(); reg++)
     {
-         // Sinon, on cherche dans les tables dont les symboles sont accessibles depuis la portée
-         while (scopeLevel > 1)
-         {
-            scopeLevel = scopeLevelRelationship[scopeLevel];
-            if (this->symbolTable[scopeLevel]->find(id) != this->symbolTable[scopeLevel]->end())
-            {
-                this->symbolTable[scopeLevel]->find(id)->second->setInitialized(true);
-            }
-         }
+        code.add_instr("popq", {*reg});
     }
+    // Appel terminal : l'appelé réutilise l'adresse de retour de notre appelant et lui répond directement
+    if (tailCallee != "")
+    {
+        code.add_instr("jmp", {tailCallee});
+        return;
+    }
+    code.add_instr("ret");
+}
+
+int CFG::add_to_symbol_table(const string &name, const string &type, bool initialized, bool isTmp)
+{
+    this->variablesInMemory++;
+    infosSymbole *symbole = arena.make<infosSymbole>(intern(type), initialized, isTmp, variablesInMemory * 4, symbols.size(), intern(name));
+    symbols.push_back(symbole);
+    varRegisters.push_back("");
+    return symbole->getIndex();
 }
 
-void CFG::add_scope_relationship(int scope, int levelCloestAccessibleScope){
-    scopeLevelRelationship.insert(pair<int, int>(scope, levelCloestAccessibleScope));
+int CFG::create_new_temp(const string &t)
+{
+    // Un temporaire n'est désigné que par son numéro : son nom n'a pas besoin d'être unique
+    return add_to_symbol_table(t, "int", true, true);
+}
+
+void CFG::import_symbols(CFG *other, vector<int> &imported)
+{
+    // Les temporaires sont laissés à l'appelant, qui les renomme à leur première rencontre
+    imported.assign(other->get_nb_symbols(), -1);
+    for (int id = 0; id < other->get_nb_symbols(); id++)
+    {
+        infosSymbole *symbol = other->get_symbol(id);
+        if (!symbol->isTemporary())
+        {
+            imported[id] = add_to_symbol_table(symbol->getName(), symbol->getType(), symbol->isInitialized(), false);
+        }
+    }
+}
+
+infosSymbole *CFG::get_symbol(int id)
+{
+    return symbols[id];
+}
+
+int CFG::get_nb_symbols()
+{
+    return symbols.size();
+}
+
+void CFG::set_var_register(int id, string reg)
+{
+    varRegisters[id] = reg;
+}
+
+string CFG::get_var_register(int id)
+{
+    return varRegisters[id];
+}
+
+void CFG::set_var_constant(int id, int value)
+{
+    varConstants[id] = value;
+}
+
+bool CFG::is_var_constant(int id)
+{
+    return varConstants.count(id) != 0;
+}
+
+void CFG::set_var_in_flags(int id)
+{
+    varInFlags[id] = true;
+}
+
+bool CFG::has_location(int id)
+{
+    return !varConstants.count(id) && !varInFlags.count(id);
+}
+
+InstructionSelector *CFG::get_selector()
+{
+    return selector;
+}
+
+int CFG::get_estimated_cost()
+{
+    return estimatedCost;
+}
+
+vector<pair<string, int>> CFG::get_peephole_stats()
+{
+    return peepholeStats;
+}
+
+void CFG::set_frame_size(int size)
+{
+    frameSize = size;
+}
+
+int CFG::get_frame_size()
+{
+    return frameSize;
+}
+
+void CFG::set_callee_saved_registers(vector<string> regs)
+{
+    calleeSavedRegisters = regs;
+}
+
+vector<string> CFG::get_callee_saved_registers()
+{
+    return calleeSavedRegisters;
+}
+
+void CFG::set_frame_layout(bool framePointer, int stackAdjust, int incomingArgsOffset)
+{
+    this->framePointer = framePointer;
+    this->stackAdjust = stackAdjust;
+    this->incomingArgsOffset = incomingArgsOffset;
+}
+
+bool CFG::has_frame_pointer()
+{
+    return framePointer;
+}
+
+int CFG::get_stack_adjust()
+{
+    return stackAdjust;
+}
+
+string CFG::incoming_arg(int i)
+{
+    return to_string(incomingArgsOffset + 8 * (i - 6)) + (framePointer ? "(%rbp)" : "(%rsp)");
+}
+
+vector<BasicBlock *> &CFG::get_bbs()
+{
+    return bbs;
 }
 
 string CFG::new_BB_name()
@@ -179,7 +324,36 @@ void CFG::add_error(string error)
     errors.push_back(error);
 }
 
-IRInstr::IRInstr(BasicBlock *bb_, Operation op, string type, vector<string> params, int scope): bb(bb_), op(op), type(type), params(params), scope(scope)
+IROperand IROperand::variable(int id)
+{
+    IROperand operand;
+    operand.kind = var;
+    operand.value = id;
+    return operand;
+}
+
+IROperand IROperand::constant(int value)
+{
+    IROperand operand;
+    operand.kind = imm;
+    operand.value = value;
+    return operand;
+}
+
+IROperand IROperand::function(const string *name)
+{
+    IROperand operand;
+    operand.kind = label;
+    operand.name = name;
+    return operand;
+}
+
+const string &IROperand::get_label() const
+{
+    return *name;
+}
+
+IRInstr::IRInstr(BasicBlock *bb_, Operation op, const string &type, vector<IROperand> params, int scope): bb(bb_), op(op), type(bb_->cfg->intern(type)), params(move(params)), scope(scope)
 {
     comparison = false;
     if(op == if_comp){
@@ -190,255 +364,147 @@ IRInstr::IRInstr(BasicBlock *bb_, Operation op, string type, vector<string> para
 BasicBlock::BasicBlock(CFG *cfg, string entry_label, int scopeLevel): cfg(cfg), label(entry_label), scope(scopeLevel)
 {}
 
-void BasicBlock::gen_asmX86(ostream &o)
+void BasicBlock::gen_asmX86(MachineCode &code, BasicBlock *next)
 {
     bool comparison = false;
+    // Saut conditionnel vers exit_false choisi par le sélecteur d'après la condition du bloc
+    string jump = "je";
     if (instrs.size())
     {
-        for (int i = 0; i < instrs.size(); i++)
-        {
-            instrs[i]->gen_asmX86(o);
-        }
+        jump = cfg->get_selector()->gen_block(this, code);
         comparison = instrs.back()->comparison;
     }
 
     if (exit_true->label == "epilogue")
     {
-        cfg->gen_asmX86_epilogue(o);
+        bool tailCall = !instrs.empty() && instrs.back()->op == IRInstr::tail_call;
+        cfg->gen_asmX86_epilogue(code, tailCall ? instrs.back()->params[1].get_label() : "");
     }
     else if (exit_true->label != "epilogue")
     {
+        // Le bloc émis juste après n'a pas besoin de saut : on y arrive en continuant
         if (exit_true != nullptr && exit_false != nullptr && comparison)
         {
-            o << "\tje " << exit_false->label << endl;
-            o << "\tjmp " << exit_true->label << endl;
+            if (exit_false == next)
+            {
+                code.add_instr(InstructionSelector::invert_jump(jump), {cfg->asm_label(exit_true)});
+            }
+            else
+            {
+                code.add_instr(jump, {cfg->asm_label(exit_false)});
+                if (exit_true != next)
+                {
+                    code.add_instr("jmp", {cfg->asm_label(exit_true)});
+                }
+            }
         }
-        else
+        else if (exit_true != next)
         {
-            o << "\tjmp " << exit_true->label << endl;
+            code.add_instr("jmp", {cfg->asm_label(exit_true)});
         }
     }
 }
 
-void BasicBlock::add_IRInstr(IRInstr::Operation op, string type, vector<string> params, int scopeLevel)
+void BasicBlock::add_IRInstr(IRInstr::Operation op, const string &type, vector<IROperand> params, int scopeLevel)
 {
-    BasicBlock* bb = this;
-    IRInstr * instr = new IRInstr(bb, op, type, params, scopeLevel);
+    IRInstr * instr = cfg->create_instr(this, op, type, move(params), scopeLevel);
     instrs.push_back(instr);
 }
 
-void IRInstr::gen_asmX86(ostream &o)
+// Position dans params de la variable écrite (-1 si aucune) et de la première variable lue
+// (les suivantes vont jusqu'à la fin de params ; params.size() si aucune), selon la disposition de IR.h
+static void operand_layout(IRInstr *instr, int &def, int &firstUse)
 {
-    this->bb->scope = scope;
-    switch (this->op)
+    def = -1;
+    firstUse = instr->params.size();
+    switch (instr->op)
     {
-        case ret:{
-            int data1 = this->bb->cfg->get_var_index(this->bb->scope, params[0]);
-            o << "	movl -" << data1 << "(%rbp), %eax\n";
+        case IRInstr::ret:
+        case IRInstr::if_comp:
+            firstUse = 0;
             break;
-        }
-        case ldconst:{
-            int data1 = this->bb->cfg->get_var_index(this->bb->scope, params[0]);
-            int constante = stoi(params[1]);
-            o << "	movl $" << constante << ", -"<<data1 <<"(%rbp)\n";
+        case IRInstr::ldconst:
+            def = 0;
             break;
-        }
-        case copy:{
-            int scope = stoi(params[2]);
-            int data1 = this->bb->cfg->get_var_index(scope, params[0]);
-            int data2 = this->bb->cfg->get_var_index(this->bb->scope, params[1]);
-            o << "	movl -" << data2 << "(%rbp), %eax" << endl;
-            o << "	movl %eax, -"<<data1 <<"(%rbp)\n";
+        case IRInstr::copy:
+        case IRInstr::add:
+        case IRInstr::sub:
+        case IRInstr::mul:
+        case IRInstr::div:
+        case IRInstr::cmp_eq:
+        case IRInstr::cmp_lt:
+        case IRInstr::cmp_le:
+        case IRInstr::cmp_ne:
+        case IRInstr::copy_not:
+        case IRInstr::copy_neg:
+        case IRInstr::phi:
+            def = 0;
+            firstUse = 1;
             break;
-        }
-        case add:{
-            int data1 = this->bb->cfg->get_var_index(this->bb->scope, params[0]);
-            int data2 = this->bb->cfg->get_var_index(stoi(params[3]), params[1]);
-            int data3 = this->bb->cfg->get_var_index(stoi(params[4]), params[2]);
-            o << "	movl -" << data2 << "(%rbp), %eax\n";
-		    o << "	addl -" << data3 << "(%rbp), %eax\n";
-		    o  << "	movl %eax, -" << data1 << "(%rbp)\n";
+        case IRInstr::call:
+        case IRInstr::tail_call:
+            def = 0;
+            firstUse = 2;
             break;
-        }
-        case sub:{
-            int data1 = this->bb->cfg->get_var_index(this->bb->scope, params[0]);
-            int data2 = this->bb->cfg->get_var_index(stoi(params[3]), params[1]);
-            int data3 = this->bb->cfg->get_var_index(stoi(params[4]), params[2]);
-            o << "	movl -" << data2 << "(%rbp), %eax\n";
-		    o << "	subl -" << data3 << "(%rbp), %eax\n";
-		    o  << "	movl %eax, -" << data1 << "(%rbp)\n";
-            break;
-        }
-        case mul:{
-            // this->create_new_tempvar("!tmp"+id)
-            int data1 = this->bb->cfg->get_var_index(this->bb->scope, params[0]);
-            int data2 = this->bb->cfg->get_var_index(stoi(params[3]), params[1]);
-            int data3 = this->bb->cfg->get_var_index(stoi(params[4]), params[2]);
-            o << "	movl -" << data2 << "(%rbp), %eax\n";
-		    o << "	imull -" << data3 << "(%rbp), %eax\n";
-		    o  << "	movl %eax, -" << data1 << "(%rbp)\n";
+        default:
             break;
-        }
-        case div:{
-            // this->create_new_tempvar("!tmp"+id)
-            int data1 = this->bb->cfg->get_var_index(this->bb->scope, params[0]);
-            int data2 = this->bb->cfg->get_var_index(stoi(params[3]), params[1]);
-            int data3 = this->bb->cfg->get_var_index(stoi(params[4]), params[2]);
-
-            o << "	movl -" << data2 << "(%rbp), %eax"<<endl;
-            o << "  cltd"<<endl;
-            o << "  idivl -" << data3 << "(%rbp)"<<endl;
-            o << "	movl %eax, -" << data1 << "(%rbp)"<<endl;
-            break;
-        }      
-        case call:{
-
-            int data1 = this->bb->cfg->get_var_index(this->bb->scope, params[0]);
-            string label_function = this->params[1];
-            int nb_params_function = this->params.size()-2;
-            int stackPointerOffset = ((this->params.size()-2))*6*16;
-
-            o << "	subq $" << stackPointerOffset <<" , %rsp" << endl;
-            if(nb_params_function>=6){
-                int param6 = this->bb->cfg->get_var_index(this->bb->scope, params[7]);
-                o << "	movl -" << param6 <<"(%rbp), %r9d" << endl;
-            }
-            if(nb_params_function>=5){
-                int param5 = this->bb->cfg->get_var_index(this->bb->scope, params[6]);
-                o << "	movl -" << param5 << "(%rbp), %r8d" << endl;
-            }
-            if(nb_params_function>=4){
-                int param4 = this->bb->cfg->get_var_index(this->bb->scope, params[5]);
-                o << "	movl -" << param4 <<"(%rbp), %ecx" << endl;
-            }
-            if(nb_params_function>=3){
-                int param3 = this->bb->cfg->get_var_index(this->bb->scope, params[4]);
-                o << "	movl -" << param3 <<"(%rbp), %edx" << endl;
-            }
-            if(nb_params_function>=2){
-                int param2 = this->bb->cfg->get_var_index(this->bb->scope, params[3]);
-                o << "	movl -" <<  param2 << "(%rbp), %esi" << endl;
-            }
-            if(nb_params_function>=1){
-                int param1 = this->bb->cfg->get_var_index(this->bb->scope, params[2]);
-                o << "	movl -" <<  param1 << "(%rbp), %edi" << endl;
-            }
+    }
+}
 
-            o << "	call " << label_function << endl;
-	        o << "	addq $" << stackPointerOffset <<" , %rsp" << endl;
-            o << "	movl %eax, -" <<  data1 << "(%rbp)" << endl;
-            break;
-        }
-        case cmp_eq:{
-            int data3 = this->bb->cfg->get_var_index(this->bb->scope, params[0]);
-            int data1 = this->bb->cfg->get_var_index(stoi(params[3]), params[1]);
-            int data2 = this->bb->cfg->get_var_index(stoi(params[4]), params[2]);
-            o << "	movl -" << data1 << "(%rbp), %eax\n";
-            o << "	cmpl -" << data2 << "(%rbp), %eax\n";
-            o << "	sete %al\n";
-            o << "	movzbl	%al, %eax\n";
-            o << "	movl	%eax, -" << data3 << "(%rbp)\n";
-            break;
-        }
-        case cmp_lt:{
-            int data3 = this->bb->cfg->get_var_index(this->bb->scope, params[0]);
-            int data1 = this->bb->cfg->get_var_index(stoi(params[3]), params[1]);
-            int data2 = this->bb->cfg->get_var_index(stoi(params[4]), params[2]);
-
-            // On mets dans %al la valeur telle que a >= b
-            o << "	movl -" << data1 << "(%rbp), %eax\n";
-            o << "	cmpl %eax, -" << data2 << "(%rbp)\n";
-            o << "	setle %al\n";
-
-            // On inverse le résultat
-            o << "	movzbl	%al, %eax\n";
-            o << "	cmpl $0, %eax\n";
-            o << "	sete %al\n";
-
-            o << "	movzbl	%al, %eax\n";
-            o << "	movl	%eax, -" << data3 << "(%rbp)\n";
-            break;
-        }
-        case cmp_le:{
-            int data3 = this->bb->cfg->get_var_index(this->bb->scope, params[0]);
-            int data1 = this->bb->cfg->get_var_index(stoi(params[3]), params[1]);
-            int data2 = this->bb->cfg->get_var_index(stoi(params[4]), params[2]);
-
-            // On mets dans %al la valeur telle que a <= b
-            o << "	movl -" << data1 << "(%rbp), %eax\n";
-            o << "	cmpl -" << data2 << "(%rbp), %eax\n";
-            o << "	setle %al\n";
-
-            o << "	movzbl	%al, %eax\n";
-            o << "	movl	%eax, -" << data3 << "(%rbp)\n";
-            break;
-        }
-        case copy_not:{
-            // On  récupère la case mémoire contenant le résultat
-            int data1 = this->bb->cfg->get_var_index(this->bb->scope, params[0]);
-            int data2 = this->bb->cfg->get_var_index(stoi(params[2]), params[1]);
-            o << "	movl -" << data2 << "(%rbp), %eax\n";
-            o << "	cmpl $0, %eax\n";
-            o << "	sete %al\n";
-            o << "	movzbl	%al, %eax\n";
-            o << "	movl	%eax, -" << data1 << "(%rbp)\n";
-            break;
-        }
-        case copy_neg:{
-            int data1 = this->bb->cfg->get_var_index(this->bb->scope, params[0]);
-            int data2 = this->bb->cfg->get_var_index(stoi(params[2]), params[1]);
-            o << "	movl -" << data2 << "(%rbp), %eax\n";
-            o << "	neg %eax\n";
-            o << "	movl %eax, -" << data1 << "(%rbp)\n";
-            break;
-        }
-        case function_params_initialisation:{
-            int nb_params_function = this->params.size();
-            if(nb_params_function>=6){
-                int param6 = this->bb->cfg->get_var_index(this->bb->scope, params[5]);
-                o << "	movl %r9d, -" << param6 <<"(%rbp)" << endl;
-            }
-            if(nb_params_function>=5){
-                int param5 = this->bb->cfg->get_var_index(this->bb->scope, params[4]);
-                o << "	movl %r8d, -" << param5 <<"(%rbp)" << endl;
-            }
-            if(nb_params_function>=4){
-                int param4 = this->bb->cfg->get_var_index(this->bb->scope, params[3]);
-                o << "	movl %ecx, -" << param4 <<"(%rbp)" << endl;
-            }
-            if(nb_params_function>=3){
-                int param3 = this->bb->cfg->get_var_index(this->bb->scope, params[2]);
-                o << "	movl %edx, -" << param3 <<"(%rbp)" << endl;
-            }
-            if(nb_params_function>=2){
-                int param2 = this->bb->cfg->get_var_index(this->bb->scope, params[1]);
-                o << "	movl %esi, -" <<  param2 << "(%rbp)" << endl;
-            }
-            if(nb_params_function>=1){
-                int param1 = this->bb->cfg->get_var_index(this->bb->scope, params[0]);
-                o << "	movl %edi, -" <<  param1 << "(%rbp)" << endl;
-            }
-            break;
-        }
-        case if_comp:{
-            int param1 = this->bb->cfg->get_var_index(stoi(params[1]), params[0]);
-            o << "\tcmpl $0, -" << param1 <<"(%rbp)"<< endl;
-            break;
-        }
-        case jne:{
-                string label = params[0];
-                o << "\tjne " << label << endl;
-            break;
-        }
-        case je:{
-            string label = params[0];
-                o << "\tje " << label << endl;
-            break;
-        }
-        case jmp:{
-            string label = params[0];
-            o << "\tjmp "<< label << endl;
+vector<int> IRInstr::get_uses()
+{
+    int def, firstUse;
+    operand_layout(this, def, firstUse);
+    vector<int> uses;
+    for (int i = firstUse; i < params.size(); i++)
+    {
+        uses.push_back(params[i].is_var() ? params[i].value : -1);
+    }
+    return uses;
+}
+
+void IRInstr::set_use_operand(int i, int var)
+{
+    int def, firstUse;
+    operand_layout(this, def, firstUse);
+    params[firstUse + i] = IROperand::variable(var);
+}
+
+void IRInstr::set_def_operand(int i, int var)
+{
+    params[this->op == function_params_initialisation ? i : 0] = IROperand::variable(var);
+}
+
+int IRInstr::get_def()
+{
+    int def, firstUse;
+    operand_layout(this, def, firstUse);
+    if (def == -1 || !params[def].is_var())
+    {
+        return -1;
+    }
+    return params[def].value;
+}
+
+vector<int> IRInstr::get_defs()
+{
+    vector<int> defs;
+    if (this->op == function_params_initialisation)
+    {
+        for (auto &param : params)
+        {
+            defs.push_back(param.value);
         }
-        default:{break;}
     }
+    else if (get_def() != -1)
+    {
+        defs.push_back(get_def());
+    }
+    return defs;
+}
+
+void IRInstr::gen_asmX86(MachineCode &code)
+{
+    // Le choix des instructions x86 revient au sélecteur du CFG
+    this->bb->cfg->get_selector()->gen_instr(this, code);
 }
@@ -9,27 +9,51 @@
 #include <list>
 #include <unordered_map>
 
+#include "Arena.h"
+#include "Interner.h"
+#include "AsmWriter.h"
+
 using namespace std;
 
 class BasicBlock;
 class CFG;
+class InstructionSelector;
+class MachineCode;
 
 // Classe définissant les entrées dans la table des symboles
 class infosSymbole
 {
 private:
-	std::string type;
+	const std::string *type; /**< nom de type interné */
 	bool initialized;
 	bool isTmp;
 	int offset;
+	int index; /**< numéro unique du symbole dans son CFG, utilisé par les analyses */
+	const std::string *name; /**< identificateur interné ; pour un temporaire, le préfixe de son nom */
 
 public:
-	infosSymbole(std::string type, bool initialized, bool isTmp, int offset) : type(type), initialized(initialized), isTmp(isTmp), offset(offset) {}
+	infosSymbole(const std::string *type, bool initialized, bool isTmp, int offset, int index, const std::string *name) : type(type), initialized(initialized), isTmp(isTmp), offset(offset), index(index), name(name) {}
 	infosSymbole() {}
+	const std::string &getName()
+	{
+		return *name;
+	}
+	const std::string &getType()
+	{
+		return *type;
+	}
 	int getOffset()
 	{
 		return offset;
 	}
+	int getIndex()
+	{
+		return index;
+	}
+	bool isTemporary()
+	{
+		return isTmp;
+	}
 	void setOffset(int of)
 	{
 		offset = of;
@@ -44,6 +68,35 @@ public:
 	}
 };
 
+/** Opérande d'une instruction IR : une variable (numéro de son symbole dans le CFG, résolu une seule
+	fois à la construction de l'instruction), une constante ou une étiquette (fonction appelée).
+	Une étiquette désigne son nom interné dans la table des chaînes de la compilation. */
+class IROperand
+{
+public:
+	typedef enum
+	{
+		none,
+		var,
+		imm,
+		label,
+	} Kind;
+
+	IROperand() : kind(none), value(-1), name(nullptr) {}
+	static IROperand variable(int id);
+	static IROperand constant(int value);
+	static IROperand function(const string *name); /**< name : exemplaire interné (CFG::intern) */
+
+	bool is_var() const { return kind == var; }
+	const string &get_label() const; /**< nom de l'étiquette d'une opérande label */
+
+	Kind kind;
+	int value; /**< numéro du symbole (var) ou valeur (imm) */
+
+private:
+	const string *name; /**< nom de l'étiquette (label) */
+};
+
 //! The class for one 3-address instruction
 class IRInstr
 {
@@ -65,6 +118,7 @@ public:
 		cmp_eq,
 		cmp_lt,
 		cmp_le,
+		cmp_ne,
 		copy_not,
 		copy_neg,
 		function_params_initialisation,
@@ -72,21 +126,38 @@ public:
 		jne,
 		je,
 		jmp,
+		phi,
+		tail_call, /**< appel terminal ("", label, params) : le résultat de l'appelé est renvoyé tel quel */
 	} Operation;
 
 	/**  constructor */
-	IRInstr(BasicBlock *bb_, Operation op, string type, vector<string> params, int scope);
+	IRInstr(BasicBlock *bb_, Operation op, const string &type, vector<IROperand> params, int scope);
 
 	/** Actual code generation */
-	void gen_asmX86(ostream &o); /**< x86 assembly code generation for this IR instruction */
+	void gen_asmX86(MachineCode &code); /**< x86 assembly code generation for this IR instruction */
+
+	/** Variable écrite par l'instruction (numéro du symbole dans le CFG), -1 si aucune */
+	int get_def();
+	/** Toutes les variables écrites (function_params_initialisation en écrit plusieurs) */
+	vector<int> get_defs();
+	/** Variables lues par l'instruction (numéros des symboles dans le CFG), dans l'ordre des params */
+	vector<int> get_uses();
+	/** Remplace la i-ème variable lue (même ordre que get_uses) */
+	void set_use_operand(int i, int var);
+	/** Remplace la i-ème variable écrite (même ordre que get_defs) */
+	void set_def_operand(int i, int var);
 
 	BasicBlock *bb; /**< The BB this instruction belongs to, which provides a pointer to the CFG this instruction belong to */
 	Operation op;
-	string type;
+	const string *type; /**< interné dans la table des chaînes de la compilation */
 	bool comparison;
 	int scope;
-	vector<string> params; /**< For 3-op instrs: d, x, y; for ldconst: d, c;  For call: label, d, params;  for wmem and rmem: choose yourself */
-						   // if you subclass IRInstr, each IRInstr subclass has its parameters and the previous (very important) comment becomes useless: it would be a better design.
+	/** Disposition des opérandes selon l'opération (d écrite, x et y lues) :
+		ret: x;  ldconst: d, $c;  copy, copy_not, copy_neg: d, x;  add ... cmp_le: d, x, y;
+		call: d, label, x1, x2...;  tail_call: -, label, x1...;  function_params_initialisation: d1, d2...;
+		if_comp: x;  phi: d, x1, x2... */
+	vector<IROperand> params;
+	vector<BasicBlock *> phiBlocks; /**< pour un phi (d, x1, x2...) : bloc prédécesseur d'où vient chaque xi */
 };
 
 /**  The class for a basic block */
@@ -109,19 +180,24 @@ public:
 	 The attribute test_var_name itself is defined when converting
   the if, while, etc of the AST to IR.
 
-Possible optimization:
-	 a cmp_* comparison instructions, if it is the last instruction of its block,
+Optimization (InstructionSelector):
+	 a cmp_* (or copy_not) whose result is only read by the if_comp ending its block
 	   generates an actual assembly comparison
-	   followed by a conditional jump to the exit_false branch
+	   followed by a conditional jump to the exit_false branch (jge for a cmp_lt, ...);
+	   the boolean itself is never materialized
+
+Optimization (Peephole):
+	 the instructions go into a MachineCode list instead of the output stream,
+	   and are rewritten by the peephole rules before being written
 */
 
 class BasicBlock
 {
 public:
 	BasicBlock(CFG *cfg, string entry_label, int scopeLevel);
-	void gen_asmX86(ostream &o); /**< x86 assembly code generation for this basic block (very simple) */
+	void gen_asmX86(MachineCode &code, BasicBlock *next); /**< x86 assembly code generation for this basic block ; next is the block emitted right after it (nullptr for the last one) */
 
-	void add_IRInstr(IRInstr::Operation op, string type, vector<string> params, int scope);
+	void add_IRInstr(IRInstr::Operation op, const string &type, vector<IROperand> params, int scope);
 
 	// No encapsulation whatsoever here. Feel free to do better.
 	int scope;
@@ -146,44 +222,90 @@ public:
 class CFG
 {
 public:
-	CFG();
+	CFG(Interner *interner);
 
 	void add_bb(BasicBlock *bb);
 
+	// allocation dans l'arène de la fonction : rien n'est libéré avant la destruction du CFG
+	BasicBlock *create_bb(string label, int scope);
+	IRInstr *create_instr(BasicBlock *bb, IRInstr::Operation op, const string &type, vector<IROperand> params, int scope);
+	Arena *get_arena();
+	const string *intern(const string &s); /**< exemplaire unique de s dans la table des chaînes de la compilation */
+
 	// x86 code generation: could be encapsulated in a processor class in a retargetable compiler
-	void gen_asmX86(ostream &o);
-	string IR_reg_to_asm(string reg); /**< helper method: inputs a IR reg or input variable, returns e.g. "-24(%rbp)" for the proper value of 24 */
-	void gen_asmX86_prologue(ostream &o);
-	void gen_asmX86_epilogue(ostream &o);
-
-	// symbol table methods
-	void add_to_symbol_table(int scopeLevel, string name, string type, bool initialized, bool isTmp);
-    bool already_defined_in_scope_symbol_table(int scopeLevel, string id);
-    int already_defined_in_another_accessible_scope(int scopeLevel, string id);
-    string create_new_tempvar(int scopeLevel, string t);
-    void create_symbol_table_scope(int scope_level);
-    int get_var_index(int scopeLevel, string name);
-    bool get_var_is_initialized(int scopeLevel, string id);
-    void set_var_is_initialized(int scopeLevel, string id);
-    void add_scope_relationship(int scope, int levelCloestAccessibleScope);
+	void gen_asmX86(AsmWriter &o); /**< ajoute le code de la fonction au tampon o, sans l'écrire */
+	string asm_label(BasicBlock *bb); /**< étiquette du bloc dans l'assembleur : le nom de la fonction pour l'entrée, .L<fonction>.<bloc> sinon */
+	string IR_reg_to_asm(int id); /**< helper method: inputs a IR reg or input variable, returns e.g. "-24(%rbp)" for the proper value of 24, or the register it was allocated to */
+	void gen_asmX86_prologue(MachineCode &code);
+	void gen_asmX86_epilogue(MachineCode &code, string tailCallee = ""); /**< rend le cadre de pile puis ret, ou jmp tailCallee pour un appel terminal */
+
+	// symbol table methods : les noms sont résolus par le front-end (SymbolTable), le CFG ne range
+	// que les symboles, à plat et indexés par leur numéro
+	int add_to_symbol_table(const string &name, const string &type, bool initialized, bool isTmp); /**< renvoie le numéro du symbole créé */
+    int create_new_temp(const string &t); /**< nouveau temporaire (t ne sert qu'à le nommer), renvoie son numéro */
+    void import_symbols(CFG *other, vector<int> &imported); /**< recopie les variables nommées de other sous de nouveaux numéros ; imported reçoit le numéro de chacune dans ce CFG (-1 pour les temporaires) */
+    infosSymbole *get_symbol(int id);
+    int get_nb_symbols();
+
+    // register allocation
+    void set_var_register(int id, string reg);
+    string get_var_register(int id);
+    void set_callee_saved_registers(vector<string> regs);
+    vector<string> get_callee_saved_registers();
+
+    // instruction selection
+    void set_var_constant(int id, int value); /**< le temporaire vaut toujours value : il devient une immédiate $value */
+    bool is_var_constant(int id);
+    void set_var_in_flags(int id); /**< le temporaire n'existe que dans les drapeaux du processeur (condition fusionnée avec son saut) */
+    bool has_location(int id); /**< faux pour les immédiates et les conditions fusionnées : ni registre ni case mémoire */
+    InstructionSelector *get_selector(); /**< sélecteur utilisé pendant gen_asmX86 */
+    int get_estimated_cost(); /**< coût estimé du code émis par le dernier gen_asmX86 */
+    vector<pair<string, int>> get_peephole_stats(); /**< applications de chaque règle du peephole par le dernier gen_asmX86 */
+
+    // taille de la zone des variables en mémoire, connue après l'attribution des cases
+    void set_frame_size(int size);
+    int get_frame_size();
+
+    // disposition du cadre de pile, calculée par FrameLayout avant l'émission
+    void set_frame_layout(bool framePointer, int stackAdjust, int incomingArgsOffset);
+    bool has_frame_pointer(); /**< faux pour une fonction feuille sans case mémoire : ni pushq %rbp ni subq */
+    int get_stack_adjust(); /**< octets réservés par subq sous %rbp : cases mémoire et arguments sortants */
+    string incoming_arg(int i); /**< emplacement du paramètre i (i >= 6), passé sur la pile par l'appelant */
 
     // basic block management
 	string new_BB_name();
 	BasicBlock *current_bb;
+	vector<BasicBlock *> &get_bbs();
 
 	/** Error : variable already declared */
 	void add_error(string error);
+	/** Affiche les erreurs et arrête la compilation s'il y en a : l'IR n'est exploitable qu'ensuite */
+	void check_errors();
+	/** Affiche les erreurs sur o sans arrêter le processus ; vrai s'il y en a */
+	bool report_errors(ostream &o);
 
 	// nom du cfg en public
 	string label;
 	int currentScope;
 
 protected:
+	Arena arena; /**< possède les blocs, les instructions et les symboles de la fonction */
+	Interner *interner;
+
 	// Table des symboles
-	unordered_map<int, unordered_map<string, infosSymbole *>*> symbolTable;
-	unordered_map<int, int> scopeLevelRelationship;
+	vector<infosSymbole *> symbols; /**< tous les symboles du CFG, indexés par leur numéro */
+	vector<string> varRegisters; /**< registre alloué à chaque symbole, vide si la variable reste en mémoire */
+	vector<string> calleeSavedRegisters; /**< registres callee-saved utilisés, sauvegardés dans le prologue */
+	unordered_map<int, int> varConstants; /**< valeur des temporaires constants */
+	unordered_map<int, bool> varInFlags;
+	InstructionSelector *selector;
+	int estimatedCost;
+	vector<pair<string, int>> peepholeStats;
+	int frameSize; /**< octets occupés par les cases -N(%rbp) */
+	bool framePointer;
+	int stackAdjust;
+	int incomingArgsOffset; /**< distance entre la base du cadre et le premier argument passé sur la pile */
 	int variablesInMemory; /**< to allocate new symbols in the symbol table */
-	int nbTmp;
 	int nextBBnumber;		  /**< just for naming */
 	vector<BasicBlock *> bbs; /**< all the basic blocks of this CFG*/
 	list<string> errors;
@@ -0,0 +1,724 @@
+#include "InstructionSelector.h"
+
+#include <unordered_map>
+#include <utility>
+
+// Coût estimé (en cycles) de chaque instruction générée, opérandes registre ou immédiate
+static const unordered_map<string, int> instructionCosts = {
+	{"movl", 1}, {"addl", 1}, {"subl", 1}, {"negl", 1}, {"leal", 1},
+	{"imull", 3}, {"cltd", 1}, {"idivl", 25}, {"sall", 1}, {"sarl", 1}, {"shrl", 1},
+	{"cmpl", 1}, {"testl", 1}, {"sete", 1}, {"setne", 1}, {"setl", 1}, {"setle", 1}, {"movzbl", 1},
+	{"subq", 1}, {"addq", 1}, {"call", 5}, {"jmp", 1}, {"je", 1}, {"jne", 1}, {"jge", 1}, {"jg", 1}, {"jl", 1}, {"jle", 1}};
+
+// Code de condition inverse, pour sauter vers exit_false quand la condition est fausse
+static const unordered_map<string, string> inverseCondition = {
+	{"e", "ne"}, {"ne", "e"}, {"l", "ge"}, {"le", "g"}, {"ge", "l"}, {"g", "le"}};
+// Registres des six premiers paramètres, dans l'ordre de l'ABI System V
+static const string paramRegisters[] = {"%edi", "%esi", "%edx", "%ecx", "%r8d", "%r9d"};
+// Surcoût d'une opérande mémoire -N(%rbp) (latence d'une lecture dans le cache L1)
+static const int memoryOperandCost = 3;
+
+static bool is_imm(const string &operand)
+{
+	return !operand.empty() && operand[0] == '$';
+}
+
+static bool is_mem(const string &operand)
+{
+	return operand.find('(') != string::npos;
+}
+
+static bool is_reg(const string &operand)
+{
+	return !operand.empty() && operand[0] == '%';
+}
+
+// Nom 64 bits d'un registre 32 bits, pour les adresses de leal
+static string reg64(const string &reg)
+{
+	if (reg.compare(0, 2, "%e") == 0)
+	{
+		return "%r" + reg.substr(2);
+	}
+	return reg.substr(0, reg.size() - 1);
+}
+
+InstructionSelector::InstructionSelector(CFG *cfg) : cfg(cfg)
+{
+}
+
+void InstructionSelector::prepare()
+{
+	int nbVars = cfg->get_nb_symbols();
+	nbUses.assign(nbVars, 0);
+	vector<int> nbDefs(nbVars, 0);
+	vector<IRInstr *> definition(nbVars, nullptr);
+	for (auto &bb : cfg->get_bbs())
+	{
+		for (auto &instr : bb->instrs)
+		{
+			for (int var : instr->get_uses())
+			{
+				if (var != -1)
+				{
+					nbUses[var]++;
+				}
+			}
+			for (int var : instr->get_defs())
+			{
+				if (var != -1)
+				{
+					nbDefs[var]++;
+					definition[var] = instr;
+				}
+			}
+		}
+	}
+	for (int var = 0; var < nbVars; var++)
+	{
+		if (cfg->get_symbol(var)->isTemporary() && nbDefs[var] == 1 && definition[var]->op == IRInstr::ldconst)
+		{
+			cfg->set_var_constant(var, definition[var]->params[1].value);
+		}
+	}
+
+	// Condition dont le seul lecteur est le if_comp qui la suit : elle reste dans les drapeaux
+	for (auto &bb : cfg->get_bbs())
+	{
+		vector<IRInstr *> &instrs = bb->instrs;
+		if (instrs.size() < 2 || bb->exit_false == nullptr || instrs.back()->op != IRInstr::if_comp)
+		{
+			continue;
+		}
+		IRInstr *test = instrs[instrs.size() - 2];
+		int var = test->get_def();
+		bool isCondition = test->op == IRInstr::cmp_eq || test->op == IRInstr::cmp_ne || test->op == IRInstr::cmp_lt || test->op == IRInstr::cmp_le || test->op == IRInstr::copy_not;
+		if (isCondition && var != -1 && cfg->get_symbol(var)->isTemporary() && nbUses[var] == 1 && nbDefs[var] == 1 && instrs.back()->get_uses()[0] == var)
+		{
+			fusedConditions.insert(test);
+			cfg->set_var_in_flags(var);
+		}
+	}
+}
+
+string InstructionSelector::operand(int var)
+{
+	return cfg->IR_reg_to_asm(var);
+}
+
+bool InstructionSelector::legal(const MachineInstr &instr)
+{
+	const string &m = instr.mnemonic;
+	const vector<string> &ops = instr.operands;
+	int nbMem = 0;
+	for (auto &op : ops)
+	{
+		nbMem += is_mem(op);
+	}
+	if (m != "leal" && nbMem > 1)
+	{
+		return false;
+	}
+	// Une immédiate ne peut pas être la destination (ni l'opérande de idivl)
+	if (!ops.empty() && is_imm(ops.back()))
+	{
+		return false;
+	}
+	// imull à une opérande (produit dans %edx:%eax) accepte une case mémoire
+	if (((m == "imull" && ops.size() > 1) || m == "leal" || m == "movzbl") && !is_reg(ops.back()))
+	{
+		return false;
+	}
+	if (m == "imull" && ops.size() == 3 && (!is_imm(ops[0]) || is_imm(ops[1])))
+	{
+		return false;
+	}
+	return true;
+}
+
+int InstructionSelector::cost(const vector<MachineInstr> &seq)
+{
+	int total = 0;
+	for (auto &instr : seq)
+	{
+		if (instr.kind != MachineInstr::instruction)
+		{
+			continue;
+		}
+		auto it = instructionCosts.find(instr.mnemonic);
+		total += it != instructionCosts.end() ? it->second : 1;
+		// L'adresse calculée par leal n'est pas un accès mémoire
+		if (instr.mnemonic != "leal")
+		{
+			for (auto &op : instr.operands)
+			{
+				total += is_mem(op) ? memoryOperandCost : 0;
+			}
+		}
+	}
+	return total;
+}
+
+vector<InstructionSelector::Sequence> InstructionSelector::stack_argument_candidates(string from, string to)
+{
+	return {{{"movl", {from, to}}},
+			{{"movl", {from, "%eax"}}, {"movl", {"%eax", to}}}};
+}
+
+InstructionSelector::Sequence InstructionSelector::cheapest(const vector<Sequence> &candidates)
+{
+	const Sequence *best = nullptr;
+	int bestCost = 0;
+	for (auto &candidate : candidates)
+	{
+		bool ok = true;
+		for (auto &instr : candidate)
+		{
+			ok = ok && legal(instr);
+		}
+		if (ok && (best == nullptr || cost(candidate) < bestCost))
+		{
+			best = &candidate;
+			bestCost = cost(candidate);
+		}
+	}
+	if (best == nullptr)
+	{
+		// Erreur interne du compilateur, pas du programme compilé : elle arrête tout le processus,
+		// y compris les autres fichiers d'une compilation groupée
+		cerr << "error: aucune sélection d'instructions possible" << endl;
+		exit(1);
+	}
+	return *best;
+}
+
+vector<InstructionSelector::Sequence> InstructionSelector::binary_candidates(IRInstr *instr, string mnemonic, bool commutative)
+{
+	vector<int> uses = instr->get_uses();
+	string d = operand(instr->get_def());
+	string a = operand(uses[0]);
+	string b = operand(uses[1]);
+	vector<Sequence> candidates;
+
+	// Calcul en place dans la destination : d = a ; d op= b
+	if (a == d)
+	{
+		candidates.push_back({{mnemonic, {b, d}}});
+	}
+	else if (b != d)
+	{
+		candidates.push_back({{"movl", {a, d}}, {mnemonic, {b, d}}});
+	}
+	else if (commutative)
+	{
+		candidates.push_back({{mnemonic, {a, d}}});
+	}
+	else if (mnemonic == "subl")
+	{
+		// d contient déjà b : d = -b + a
+		candidates.push_back({{"negl", {d}}, {"addl", {a, d}}});
+	}
+
+	// Passage par %eax : toujours légal
+	candidates.push_back({{"movl", {a, "%eax"}}, {mnemonic, {b, "%eax"}}, {"movl", {"%eax", d}}});
+
+	if (mnemonic == "addl")
+	{
+		// leal calcule la somme de deux registres, ou d'un registre et d'une constante, sans écraser d'opérande
+		if (is_reg(a) && is_reg(b))
+		{
+			candidates.push_back({{"leal", {"(" + reg64(a) + "," + reg64(b) + ")", d}}});
+		}
+		else if (is_reg(a) && is_imm(b))
+		{
+			candidates.push_back({{"leal", {b.substr(1) + "(" + reg64(a) + ")", d}}});
+		}
+		else if (is_imm(a) && is_reg(b))
+		{
+			candidates.push_back({{"leal", {a.substr(1) + "(" + reg64(b) + ")", d}}});
+		}
+	}
+	if (mnemonic == "imull")
+	{
+		// Forme à trois opérandes : d = a * $c
+		if (is_imm(b))
+		{
+			candidates.push_back({{"imull", {b, a, d}}});
+		}
+		if (is_imm(a))
+		{
+			candidates.push_back({{"imull", {a, b, d}}});
+		}
+	}
+	return candidates;
+}
+
+void InstructionSelector::add_mul_constant_candidates(string d, string x, int c, vector<Sequence> &candidates)
+{
+	if (c == 0)
+	{
+		candidates.push_back({{"movl", {"$0", d}}});
+		return;
+	}
+	// c = ±(3, 5 ou 9)^i * 2^k : un leal (x, x, s) par facteur 3, 5 ou 9, puis un décalage
+	long long magnitude = c < 0 ? -(long long)c : c;
+	vector<int> scales;
+	int shift = 0;
+	while (magnitude % 2 == 0)
+	{
+		magnitude /= 2;
+		shift++;
+	}
+	for (int factor : {9, 5, 3})
+	{
+		while (magnitude % factor == 0 && scales.size() < 2)
+		{
+			magnitude /= factor;
+			scales.push_back(factor - 1);
+		}
+	}
+	if (magnitude != 1)
+	{
+		return;
+	}
+
+	// Le calcul se fait dans le registre destination, ou dans %eax si d est en mémoire
+	string work = is_reg(d) ? d : "%eax";
+	string source = x;
+	Sequence seq;
+	auto load = [&]() {
+		if (source != work)
+		{
+			seq.push_back({"movl", {source, work}});
+			source = work;
+		}
+	};
+	for (int scale : scales)
+	{
+		if (!is_reg(source))
+		{
+			load();
+		}
+		seq.push_back({"leal", {"(" + reg64(source) + "," + reg64(source) + "," + to_string(scale) + ")", work}});
+		source = work;
+	}
+	load();
+	if (shift > 0)
+	{
+		seq.push_back({"sall", {"$" + to_string(shift), work}});
+	}
+	if (c < 0)
+	{
+		seq.push_back({"negl", {work}});
+	}
+	if (work != d)
+	{
+		seq.push_back({"movl", {work, d}});
+	}
+	candidates.push_back(seq);
+}
+
+void InstructionSelector::add_div_constant_candidates(string d, string x, int c, vector<Sequence> &candidates)
+{
+	if (c == 0)
+	{
+		return;
+	}
+	if (c == 1 || c == -1)
+	{
+		Sequence seq = {{"movl", {x, "%eax"}}};
+		if (c == -1)
+		{
+			seq.push_back({"negl", {"%eax"}});
+		}
+		seq.push_back({"movl", {"%eax", d}});
+		candidates.push_back(seq);
+		return;
+	}
+
+	long long magnitude = c < 0 ? -(long long)c : c;
+	if ((magnitude & (magnitude - 1)) == 0)
+	{
+		// x / 2^k arrondi vers zéro : on ajoute 2^k - 1 aux dividendes négatifs avant le décalage arithmétique
+		int k = __builtin_ctzll(magnitude);
+		Sequence seq = {{"movl", {x, "%eax"}},
+						{"cltd", {}},
+						{"shrl", {"$" + to_string(32 - k), "%edx"}},
+						{"addl", {"%edx", "%eax"}},
+						{"sarl", {"$" + to_string(k), "%eax"}}};
+		if (c < 0)
+		{
+			seq.push_back({"negl", {"%eax"}});
+		}
+		seq.push_back({"movl", {"%eax", d}});
+		candidates.push_back(seq);
+		return;
+	}
+
+	// Multiplication par l'inverse : q = mulhi(x, M) >> s, corrigé de x si M et c sont de signes
+	// opposés, plus 1 si le quotient est négatif (Hacker's Delight, 10-1)
+	int multiplier, shift;
+	magic_number(c, multiplier, shift);
+	Sequence seq = {{"movl", {"$" + to_string(multiplier), "%eax"}},
+					{"imull", {x}}};
+	if (c > 0 && multiplier < 0)
+	{
+		seq.push_back({"addl", {x, "%edx"}});
+	}
+	else if (c < 0 && multiplier > 0)
+	{
+		seq.push_back({"subl", {x, "%edx"}});
+	}
+	if (shift > 0)
+	{
+		seq.push_back({"sarl", {"$" + to_string(shift), "%edx"}});
+	}
+	seq.push_back({"movl", {"%edx", "%eax"}});
+	seq.push_back({"shrl", {"$31", "%eax"}});
+	seq.push_back({"addl", {"%eax", "%edx"}});
+	seq.push_back({"movl", {"%edx", d}});
+	candidates.push_back(seq);
+}
+
+void InstructionSelector::magic_number(int c, int &multiplier, int &shift)
+{
+	const unsigned int two31 = 0x80000000u;
+	unsigned int ad = c < 0 ? 0u - (unsigned int)c : (unsigned int)c;
+	unsigned int t = two31 + ((unsigned int)c >> 31);
+	unsigned int anc = t - 1 - t % ad;
+	int p = 31;
+	unsigned int q1 = two31 / anc, r1 = two31 - q1 * anc;
+	unsigned int q2 = two31 / ad, r2 = two31 - q2 * ad;
+	unsigned int delta;
+	do
+	{
+		p++;
+		q1 = 2 * q1;
+		r1 = 2 * r1;
+		if (r1 >= anc)
+		{
+			q1++;
+			r1 -= anc;
+		}
+		q2 = 2 * q2;
+		r2 = 2 * r2;
+		if (r2 >= ad)
+		{
+			q2++;
+			r2 -= ad;
+		}
+		delta = ad - r2;
+	} while (q1 < delta || (q1 == delta && r1 == 0));
+	multiplier = (int)(q2 + 1);
+	if (c < 0)
+	{
+		multiplier = -multiplier;
+	}
+	shift = p - 32;
+}
+
+InstructionSelector::Sequence InstructionSelector::compare(string x, string y)
+{
+	if (is_imm(y) || (is_mem(x) && is_mem(y)))
+	{
+		return {{"movl", {y, "%eax"}}, {"cmpl", {x, "%eax"}}};
+	}
+	return {{"cmpl", {x, y}}};
+}
+
+InstructionSelector::Sequence InstructionSelector::condition(IRInstr *instr, string &cc)
+{
+	vector<int> uses = instr->get_uses();
+	string a = operand(uses[0]);
+	if (instr->op == IRInstr::copy_not)
+	{
+		// Test à zéro : testl sur un registre, cmpl $0 sur une case mémoire
+		cc = "e";
+		return cheapest({{{"testl", {a, a}}},
+						 {{"cmpl", {"$0", a}}},
+						 {{"movl", {a, "%eax"}}, {"testl", {"%eax", "%eax"}}}});
+	}
+	switch (instr->op)
+	{
+		case IRInstr::cmp_eq:
+			cc = "e";
+			break;
+		case IRInstr::cmp_ne:
+			cc = "ne";
+			break;
+		case IRInstr::cmp_lt:
+			cc = "l";
+			break;
+		default:
+			cc = "le";
+			break;
+	}
+	// Drapeaux de a - b
+	return compare(operand(uses[1]), a);
+}
+
+vector<InstructionSelector::Sequence> InstructionSelector::set_flag_candidates(Sequence flags, string setcc, string dest)
+{
+	Sequence direct = flags;
+	direct.push_back({setcc, {"%al"}});
+	direct.push_back({"movzbl", {"%al", dest}});
+	Sequence viaEax = flags;
+	viaEax.push_back({setcc, {"%al"}});
+	viaEax.push_back({"movzbl", {"%al", "%eax"}});
+	viaEax.push_back({"movl", {"%eax", dest}});
+	return {direct, viaEax};
+}
+
+InstructionSelector::Sequence InstructionSelector::select(IRInstr *instr)
+{
+	switch (instr->op)
+	{
+		case IRInstr::ret:
+			return {{"movl", {operand(instr->get_uses()[0]), "%eax"}}};
+		case IRInstr::ldconst:
+		{
+			// Un temporaire constant n'est jamais matérialisé : ses lecteurs utilisent $c
+			int var = instr->get_def();
+			if (var != -1 && cfg->is_var_constant(var))
+			{
+				return {};
+			}
+			return {{"movl", {"$" + to_string(instr->params[1].value), operand(instr->get_def())}}};
+		}
+		case IRInstr::copy:
+		{
+			string d = operand(instr->get_def());
+			string s = operand(instr->get_uses()[0]);
+			if (d == s)
+			{
+				return {};
+			}
+			return cheapest({{{"movl", {s, d}}},
+							 {{"movl", {s, "%eax"}}, {"movl", {"%eax", d}}}});
+		}
+		case IRInstr::add:
+			return cheapest(binary_candidates(instr, "addl", true));
+		case IRInstr::sub:
+			return cheapest(binary_candidates(instr, "subl", false));
+		case IRInstr::mul:
+		{
+			vector<Sequence> candidates = binary_candidates(instr, "imull", true);
+			vector<int> uses = instr->get_uses();
+			string d = operand(instr->get_def());
+			string a = operand(uses[0]);
+			string b = operand(uses[1]);
+			if (is_imm(a) && !is_imm(b))
+			{
+				swap(a, b);
+			}
+			if (is_imm(b) && !is_imm(a))
+			{
+				add_mul_constant_candidates(d, a, stoi(b.substr(1)), candidates);
+			}
+			return cheapest(candidates);
+		}
+		case IRInstr::div:
+		{
+			vector<int> uses = instr->get_uses();
+			string d = operand(instr->get_def());
+			string a = operand(uses[0]);
+			string b = operand(uses[1]);
+			Sequence seq = {{"movl", {a, "%eax"}}, {"cltd", {}}};
+			vector<Sequence> candidates;
+			if (is_imm(b) && !is_imm(a))
+			{
+				add_div_constant_candidates(d, a, stoi(b.substr(1)), candidates);
+			}
+			// idivl n'accepte pas d'immédiate : le diviseur constant passe par %ecx
+			if (is_imm(b))
+			{
+				seq.push_back({"movl", {b, "%ecx"}});
+				b = "%ecx";
+			}
+			seq.push_back({"idivl", {b}});
+			seq.push_back({"movl", {"%eax", d}});
+			candidates.push_back(seq);
+			return cheapest(candidates);
+		}
+		case IRInstr::cmp_eq:
+		case IRInstr::cmp_ne:
+		case IRInstr::cmp_lt:
+		case IRInstr::cmp_le:
+		case IRInstr::copy_not:
+		{
+			string cc;
+			Sequence flags = condition(instr, cc);
+			return cheapest(set_flag_candidates(flags, "set" + cc, operand(instr->get_def())));
+		}
+		case IRInstr::copy_neg:
+		{
+			string d = operand(instr->get_def());
+			string s = operand(instr->get_uses()[0]);
+			Sequence inPlace;
+			if (s != d)
+			{
+				inPlace.push_back({"movl", {s, d}});
+			}
+			inPlace.push_back({"negl", {d}});
+			return cheapest({inPlace,
+							 {{"movl", {s, "%eax"}}, {"negl", {"%eax"}}, {"movl", {"%eax", d}}}});
+		}
+		case IRInstr::call:
+		{
+			string d = operand(instr->get_def());
+			vector<int> args = instr->get_uses();
+			// Les arguments à partir du septième vont dans la zone d'arguments sortants réservée par
+			// FrameLayout au bas du cadre : %rsp reste en place (et aligné) pendant l'appel
+			Sequence seq;
+			for (int i = 6; i < args.size(); i++)
+			{
+				Sequence store = cheapest(stack_argument_candidates(operand(args[i]), to_string(8 * (i - 6)) + "(%rsp)"));
+				seq.insert(seq.end(), store.begin(), store.end());
+			}
+			// Les paramètres sont passés dans l'ordre de l'ABI System V
+			for (int i = min((int)args.size(), 6) - 1; i >= 0; i--)
+			{
+				seq.push_back({"movl", {operand(args[i]), paramRegisters[i]}});
+			}
+			seq.push_back({"call", {instr->params[1].get_label()}});
+			seq.push_back({"movl", {"%eax", d}});
+			return seq;
+		}
+		case IRInstr::tail_call:
+		{
+			// Seuls les arguments sont placés : le bloc se termine par le jmp de l'épilogue
+			vector<int> args = instr->get_uses();
+			Sequence seq;
+			for (int i = min((int)args.size(), 6) - 1; i >= 0; i--)
+			{
+				seq.push_back({"movl", {operand(args[i]), paramRegisters[i]}});
+			}
+			return seq;
+		}
+		case IRInstr::function_params_initialisation:
+		{
+			Sequence seq;
+			// Les paramètres passés sur la pile sont relus au-dessus de l'adresse de retour
+			for (int i = 6; i < instr->params.size(); i++)
+			{
+				Sequence load = cheapest(stack_argument_candidates(cfg->incoming_arg(i), operand(instr->params[i].value)));
+				seq.insert(seq.end(), load.begin(), load.end());
+			}
+			for (int i = min((int)instr->params.size(), 6) - 1; i >= 0; i--)
+			{
+				seq.push_back({"movl", {paramRegisters[i], operand(instr->params[i].value)}});
+			}
+			return seq;
+		}
+		case IRInstr::if_comp:
+		{
+			// Comparaison à zéro : testl sur un registre, cmpl $0 sur une case mémoire
+			string v = operand(instr->get_uses()[0]);
+			return cheapest({{{"testl", {v, v}}},
+							 {{"cmpl", {"$0", v}}},
+							 {{"movl", {v, "%eax"}}, {"testl", {"%eax", "%eax"}}}});
+		}
+		case IRInstr::jne:
+		case IRInstr::je:
+		case IRInstr::jmp:
+			return {{instr->op == IRInstr::jne ? "jne" : instr->op == IRInstr::je ? "je" : "jmp", {instr->params[0].get_label()}}};
+		default:
+			return {};
+	}
+}
+
+bool InstructionSelector::match_lea(IRInstr *mul, IRInstr *add, Sequence &seq)
+{
+	int y = mul->get_def();
+	if (y == -1 || !cfg->get_symbol(y)->isTemporary() || nbUses[y] != 1)
+	{
+		return false;
+	}
+	vector<int> addUses = add->get_uses();
+	int other;
+	if (addUses[1] == y && addUses[0] != y)
+	{
+		other = 0;
+	}
+	else if (addUses[0] == y && addUses[1] != y)
+	{
+		other = 1;
+	}
+	else
+	{
+		return false;
+	}
+
+	// L'un des facteurs doit être une échelle d'adressage, l'autre un registre
+	vector<int> mulOperands = mul->get_uses();
+	string index, scale;
+	for (int i = 0; i < 2; i++)
+	{
+		string factor = operand(mulOperands[i]);
+		string candidate = operand(mulOperands[1 - i]);
+		if ((factor == "$1" || factor == "$2" || factor == "$4" || factor == "$8") && is_reg(candidate))
+		{
+			index = candidate;
+			scale = factor.substr(1);
+		}
+	}
+	string base = operand(addUses[other]);
+	string d = operand(add->get_def());
+	if (index.empty() || !is_reg(d) || is_mem(base))
+	{
+		return false;
+	}
+	string address = is_imm(base) ? base.substr(1) + "(," + reg64(index) + "," + scale + ")"
+								   : "(" + reg64(base) + "," + reg64(index) + "," + scale + ")";
+	seq = {{"leal", {address, d}}};
+	return true;
+}
+
+void InstructionSelector::emit(const Sequence &seq, MachineCode &code)
+{
+	for (auto &instr : seq)
+	{
+		code.add_instr(instr);
+	}
+}
+
+void InstructionSelector::gen_instr(IRInstr *instr, MachineCode &code)
+{
+	emit(select(instr), code);
+}
+
+string InstructionSelector::invert_jump(const string &jump)
+{
+	return "j" + invert_condition(jump.substr(1));
+}
+
+string InstructionSelector::invert_condition(const string &cc)
+{
+	return inverseCondition.at(cc);
+}
+
+string InstructionSelector::gen_block(BasicBlock *bb, MachineCode &code)
+{
+	vector<IRInstr *> &instrs = bb->instrs;
+	for (int i = 0; i < instrs.size(); i++)
+	{
+		Sequence lea;
+		if (fusedConditions.count(instrs[i]))
+		{
+			// cmp_* puis if_comp : seuls les drapeaux sont calculés, le saut prend la condition inverse
+			string cc;
+			emit(condition(instrs[i], cc), code);
+			return "j" + inverseCondition.at(cc);
+		}
+		if (i + 1 < instrs.size() && instrs[i]->op == IRInstr::mul && instrs[i + 1]->op == IRInstr::add && match_lea(instrs[i], instrs[i + 1], lea) && cost(lea) < cost(select(instrs[i])) + cost(select(instrs[i + 1])))
+		{
+			emit(lea, code);
+			i++;
+		}
+		else
+		{
+			gen_instr(instrs[i], code);
+		}
+	}
+	return "je";
+}
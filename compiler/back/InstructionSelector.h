@@ -0,0 +1,98 @@
+#ifndef INSTRUCTION_SELECTOR_H
+#define INSTRUCTION_SELECTOR_H
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <unordered_set>
+
+#include "IR.h"
+#include "MachineCode.h"
+
+using namespace std;
+
+/** Sélection d'instructions x86-64 par motifs et par coût.
+
+	Pour chaque instruction de l'IR, plusieurs séquences x86 équivalentes sont proposées
+	(opérande immédiate $c, opérande mémoire -N(%rbp), calcul en place dans le registre
+	destination, leal, passage par %eax...). Les séquences illégales en x86 (deux opérandes
+	mémoire, immédiate en destination...) sont écartées, puis la moins chère d'après la table
+	des coûts est émise.
+
+	Un temporaire défini une seule fois par un ldconst devient une opérande immédiate : il n'a
+	besoin ni de registre ni de case mémoire, et son ldconst n'est pas émis. Un mul par 1, 2, 4
+	ou 8 suivi d'un add qui consomme son résultat est couvert par un seul leal (base, index, échelle).
+
+	Réduction de force : une multiplication par une constante est aussi proposée en leal, sall et
+	negl, une division par ±2^k en décalage arithmétique corrigé pour arrondir vers zéro, et une
+	division par une autre constante en multiplication par son inverse (imull à une opérande, dont
+	on garde la moitié haute %edx). La table des coûts les préfère à imull et idivl quand elles
+	sont moins chères.
+
+	Une comparaison (cmp_*, copy_not) lue seulement par le if_comp qui termine son bloc est fusionnée
+	avec le saut : seul le cmpl (ou testl) est émis, et le bloc saute vers exit_false avec le jcc
+	de la condition inverse. Le booléen n'est jamais matérialisé.
+
+	%eax, %edx et %ecx servent de registres de travail : ils ne sont jamais alloués aux variables.
+*/
+class InstructionSelector
+{
+public:
+	InstructionSelector(CFG *cfg);
+
+	/** Repère les temporaires constants et les conditions fusionnées ; à appeler avant l'allocation de registres */
+	void prepare();
+
+	/** Ajoute au code les instructions d'un bloc (sans les sauts de fin de bloc) ;
+		renvoie le saut conditionnel à prendre vers exit_false */
+	string gen_block(BasicBlock *bb, MachineCode &code);
+
+	/** Saut conditionnel pris exactement quand jump ne l'est pas (je -> jne, jge -> jl...) */
+	static string invert_jump(const string &jump);
+	/** Code de condition inverse (e -> ne, l -> ge...) */
+	static string invert_condition(const string &cc);
+
+	/** Ajoute au code une instruction seule */
+	void gen_instr(IRInstr *instr, MachineCode &code);
+
+	/** Coût estimé d'une suite d'instructions, d'après la table des coûts (étiquettes et directives exclues) */
+	static int cost(const vector<MachineInstr> &seq);
+
+private:
+	typedef vector<MachineInstr> Sequence;
+
+	static bool legal(const MachineInstr &instr);
+
+	/** Séquence la moins chère parmi les candidates légales */
+	Sequence cheapest(const vector<Sequence> &candidates);
+	Sequence select(IRInstr *instr);
+
+	/** Copie d'un argument passé sur la pile, directe ou par %eax si les deux opérandes sont en mémoire */
+	vector<Sequence> stack_argument_candidates(string from, string to);
+	vector<Sequence> binary_candidates(IRInstr *instr, string mnemonic, bool commutative);
+	/** Réduction de force de d = x * c : leal (x, x, 2|4|8), sall et negl au lieu de imull */
+	void add_mul_constant_candidates(string d, string x, int c, vector<Sequence> &candidates);
+	/** Réduction de force de d = x / c : décalage corrigé si |c| = 2^k, multiplication par l'inverse sinon */
+	void add_div_constant_candidates(string d, string x, int c, vector<Sequence> &candidates);
+	/** Multiplicateur M et décalage s tels que x / c = (mulhi(x, M) >> s) corrigé, pour |c| >= 2 */
+	static void magic_number(int c, int &multiplier, int &shift);
+	/** Positionne les drapeaux comme cmpl x, y (y - x) */
+	Sequence compare(string x, string y);
+	/** Positionne les drapeaux pour une comparaison ou un test à zéro ; cc reçoit le code de condition vraie */
+	Sequence condition(IRInstr *instr, string &cc);
+	/** Range dans dest le booléen lu dans les drapeaux par setcc */
+	vector<Sequence> set_flag_candidates(Sequence flags, string setcc, string dest);
+
+	/** Motif sur deux instructions voisines : y = b * s ; d = x + y devient leal x(, b, s) */
+	bool match_lea(IRInstr *mul, IRInstr *add, Sequence &seq);
+
+	void emit(const Sequence &seq, MachineCode &code);
+
+	string operand(int var);
+
+	CFG *cfg;
+	vector<int> nbUses; /**< nombre de lectures de chaque symbole */
+	unordered_set<IRInstr *> fusedConditions; /**< comparaisons émises avec le saut de leur bloc */
+};
+
+#endif
@@ -0,0 +1,48 @@
+#include "Interner.h"
+
+#include <mutex>
+
+int Interner::intern(const string &s)
+{
+	{
+		shared_lock<shared_mutex> reading(lock);
+		auto found = ids.find(s);
+		if (found != ids.end())
+		{
+			return found->second;
+		}
+	}
+	// Un autre thread a pu ajouter s entre les deux verrous : insert rend alors son numéro
+	unique_lock<shared_mutex> writing(lock);
+	auto inserted = ids.insert({s, (int)strings.size()});
+	if (inserted.second)
+	{
+		strings.push_back(&inserted.first->first);
+	}
+	return inserted.first->second;
+}
+
+int Interner::find(const string &s)
+{
+	shared_lock<shared_mutex> reading(lock);
+	auto found = ids.find(s);
+	return found != ids.end() ? found->second : -1;
+}
+
+const string *Interner::get(int id)
+{
+	shared_lock<shared_mutex> reading(lock);
+	return strings[id];
+}
+
+const string *Interner::get(const string &s)
+{
+	int id = intern(s);
+	return get(id);
+}
+
+int Interner::size()
+{
+	shared_lock<shared_mutex> reading(lock);
+	return strings.size();
+}
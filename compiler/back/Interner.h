@@ -0,0 +1,35 @@
+#ifndef INTERNER_H
+#define INTERNER_H
+
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/** Table des chaînes d'une compilation : identificateurs et noms de types.
+
+	Chaque chaîne n'est rangée qu'une fois et reçoit un numéro. Les symboles et les instructions
+	gardent un pointeur vers l'exemplaire unique au lieu d'une copie, et deux chaînes internées sont
+	égales si et seulement si leurs pointeurs (ou leurs numéros) le sont.
+
+	La table est partagée par les fonctions compilées en parallèle (-j) : les recherches se font
+	sous un verrou partagé, seul l'ajout d'une nouvelle chaîne prend le verrou exclusif.
+*/
+class Interner
+{
+public:
+	int intern(const string &s);		   /**< numéro de s, attribué à sa première rencontre */
+	int find(const string &s);			   /**< numéro de s, -1 si elle n'a jamais été internée */
+	const string *get(int id);			   /**< exemplaire unique, valable jusqu'à la destruction de l'interner */
+	const string *get(const string &s);	   /**< exemplaire unique de s, interné si besoin */
+	int size();
+
+private:
+	shared_mutex lock;
+	unordered_map<string, int> ids;
+	vector<const string *> strings; /**< clés de ids, indexées par numéro : les noeuds de la table ne bougent pas */
+};
+
+#endif
@@ -0,0 +1,32 @@
+#include "Liveness.h"
+
+Liveness::Liveness(CFG *cfg) : GenKillAnalysis(cfg, cfg->get_nb_symbols(), backward, meet_union), cfg(cfg), nbVars(cfg->get_nb_symbols()),
+							   order(graph.blocks), blockIndex(graph.blockIndex), liveIn(in), liveOut(out)
+{
+}
+
+void Liveness::run()
+{
+	// Variables lues avant d'être écrites (gen = use) et variables écrites (kill = def) dans chaque bloc
+	for (int b = 0; b < order.size(); b++)
+	{
+		for (auto &instr : order[b]->instrs)
+		{
+			for (int var : instr->get_uses())
+			{
+				if (var != -1 && !kill[b][var])
+				{
+					gen[b].set(var);
+				}
+			}
+			for (int var : instr->get_defs())
+			{
+				if (var != -1)
+				{
+					kill[b].set(var);
+				}
+			}
+		}
+	}
+	solve();
+}
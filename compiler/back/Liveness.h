@@ -0,0 +1,32 @@
+#ifndef LIVENESS_H
+#define LIVENESS_H
+
+#include <vector>
+#include <unordered_map>
+
+#include "IR.h"
+#include "DataFlow.h"
+
+using namespace std;
+
+/** Analyse de vivacité des symboles d'un CFG, bloc par bloc.
+
+	Les blocs sont numérotés dans l'ordre d'émission de CFG::gen_asmX86 (sans prologue ni épilogue),
+	les variables par leur numéro dans la table des symboles (infosSymbole::getIndex).
+*/
+class Liveness : public GenKillAnalysis
+{
+public:
+	Liveness(CFG *cfg);
+
+	/** Point fixe arrière : out = U in(succ), in = use U (out - def) */
+	void run();
+
+	CFG *cfg;
+	int nbVars;
+	vector<BasicBlock *> &order; /**< blocs dans l'ordre d'émission */
+	unordered_map<BasicBlock *, int> &blockIndex;
+	vector<BitVector> &liveIn, &liveOut;
+};
+
+#endif
@@ -0,0 +1,52 @@
+#include "MachineCode.h"
+
+void MachineCode::add_instr(const MachineInstr &instr)
+{
+	instrs.push_back(instr);
+}
+
+void MachineCode::add_instr(string mnemonic, vector<string> operands)
+{
+	instrs.push_back({mnemonic, operands, MachineInstr::instruction});
+}
+
+void MachineCode::add_label(string name)
+{
+	instrs.push_back({name, {}, MachineInstr::label});
+}
+
+void MachineCode::add_directive(string name, string argument)
+{
+	instrs.push_back({name, {argument}, MachineInstr::directive});
+}
+
+void MachineCode::write(AsmWriter &o) const
+{
+	for (auto &instr : instrs)
+	{
+		switch (instr.kind)
+		{
+			case MachineInstr::label:
+				o.put(instr.mnemonic);
+				o.put(":\n", 2);
+				break;
+			case MachineInstr::directive:
+				o.put('\n');
+				o.put(instr.mnemonic);
+				o.put(' ');
+				o.put(instr.operands[0]);
+				o.put('\n');
+				break;
+			default:
+				o.put('\t');
+				o.put(instr.mnemonic);
+				for (int i = 0; i < instr.operands.size(); i++)
+				{
+					o.put(i == 0 ? " " : ", ", i == 0 ? 1 : 2);
+					o.put(instr.operands[i]);
+				}
+				o.put('\n');
+				break;
+		}
+	}
+}
@@ -0,0 +1,47 @@
+#ifndef MACHINE_CODE_H
+#define MACHINE_CODE_H
+
+#include <vector>
+#include <string>
+#include <iostream>
+
+#include "AsmWriter.h"
+
+using namespace std;
+
+/** Une ligne du code x86 émis : instruction (mnémonique et opérandes dans l'ordre AT&T),
+	étiquette (le nom est mnemonic) ou directive (.globl nom, pour le seul point d'entrée de la fonction) */
+struct MachineInstr
+{
+	enum Kind
+	{
+		instruction,
+		label,
+		directive
+	};
+
+	string mnemonic;
+	vector<string> operands;
+	Kind kind = instruction;
+};
+
+/** Code x86 d'une fonction, construit par le sélecteur d'instructions avant d'être écrit.
+
+	Le code reste une liste d'instructions jusqu'à write() : le peephole peut ainsi le réécrire
+	après la sélection, quand les registres et les cases mémoire sont connus.
+*/
+class MachineCode
+{
+public:
+	void add_instr(const MachineInstr &instr);
+	void add_instr(string mnemonic, vector<string> operands = {});
+	void add_label(string name);
+	void add_directive(string name, string argument);
+
+	/** Ajoute le code au tampon de sortie, au format de l'assembleur GNU */
+	void write(AsmWriter &o) const;
+
+	vector<MachineInstr> instrs;
+};
+
+#endif
@@ -0,0 +1,235 @@
+#include "Peephole.h"
+#include "InstructionSelector.h"
+
+#include <set>
+
+static bool is_mem(const string &operand)
+{
+	return operand.find('(') != string::npos;
+}
+
+static bool is_move(const MachineInstr &instr)
+{
+	return instr.kind == MachineInstr::instruction && instr.mnemonic == "movl";
+}
+
+static bool is_jump(const MachineInstr &instr)
+{
+	return instr.kind == MachineInstr::instruction && instr.mnemonic[0] == 'j';
+}
+
+Peephole::Peephole(MachineCode *code) : code(code)
+{
+	rules = {{"copies inutiles supprimées", &Peephole::self_move, 0},
+			 {"rangements ou chargements redondants supprimés", &Peephole::redundant_move, 0},
+			 {"relectures de la pile remplacées par une copie", &Peephole::store_load, 0},
+			 {"sauts vers l'instruction suivante supprimés", &Peephole::jump_to_next, 0},
+			 {"sauts conditionnels par-dessus un jmp inversés", &Peephole::branch_over_jump, 0},
+			 {"doubles normalisations de booléens supprimées", &Peephole::boolean_normalization, 0}};
+}
+
+int Peephole::run()
+{
+	vector<MachineInstr> input;
+	swap(input, code->instrs);
+	vector<MachineInstr> &out = code->instrs;
+	int rewrites = 0;
+	for (auto &instr : input)
+	{
+		out.push_back(instr);
+		// Une réécriture peut en permettre une autre sur la nouvelle fin du code
+		bool changed = true;
+		while (changed && !out.empty())
+		{
+			changed = false;
+			for (auto &rule : rules)
+			{
+				if ((this->*rule.apply)(out))
+				{
+					rule.hits++;
+					rewrites++;
+					changed = true;
+					break;
+				}
+			}
+		}
+	}
+	return rewrites;
+}
+
+vector<pair<string, int>> Peephole::get_stats()
+{
+	vector<pair<string, int>> stats;
+	for (auto &rule : rules)
+	{
+		stats.push_back({rule.name, rule.hits});
+	}
+	return stats;
+}
+
+int Peephole::previous_instr(const vector<MachineInstr> &out, int end)
+{
+	for (int i = end - 1; i >= 0; i--)
+	{
+		if (out[i].kind == MachineInstr::instruction)
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+bool Peephole::self_move(vector<MachineInstr> &out)
+{
+	MachineInstr &last = out.back();
+	if (is_move(last) && last.operands[0] == last.operands[1])
+	{
+		out.pop_back();
+		return true;
+	}
+	return false;
+}
+
+bool Peephole::redundant_move(vector<MachineInstr> &out)
+{
+	int n = out.size();
+	if (n < 2 || !is_move(out[n - 2]) || !is_move(out[n - 1]))
+	{
+		return false;
+	}
+	// Après movl A, B les deux emplacements sont égaux : recopier l'un dans l'autre ne change rien
+	vector<string> &first = out[n - 2].operands;
+	vector<string> &second = out[n - 1].operands;
+	if ((second[0] == first[1] && second[1] == first[0]) || second == first)
+	{
+		out.pop_back();
+		return true;
+	}
+	return false;
+}
+
+bool Peephole::store_load(vector<MachineInstr> &out)
+{
+	int n = out.size();
+	if (n < 2 || !is_move(out[n - 2]) || !is_move(out[n - 1]))
+	{
+		return false;
+	}
+	vector<string> &store = out[n - 2].operands;
+	vector<string> &load = out[n - 1].operands;
+	if (is_mem(store[1]) && !is_mem(store[0]) && load[0] == store[1] && load[1] != store[0])
+	{
+		load[0] = store[0];
+		return true;
+	}
+	return false;
+}
+
+bool Peephole::jump_to_next(vector<MachineInstr> &out)
+{
+	int n = out.size();
+	if (out[n - 1].kind != MachineInstr::label)
+	{
+		return false;
+	}
+	// Seules des étiquettes et des directives séparent le saut de sa cible
+	int p = previous_instr(out, n - 1);
+	if (p != -1 && is_jump(out[p]) && out[p].operands[0] == out[n - 1].mnemonic)
+	{
+		out.erase(out.begin() + p);
+		return true;
+	}
+	return false;
+}
+
+bool Peephole::branch_over_jump(vector<MachineInstr> &out)
+{
+	int n = out.size();
+	if (out[n - 1].kind != MachineInstr::label)
+	{
+		return false;
+	}
+	int p = previous_instr(out, n - 1);
+	if (p < 1 || out[p].mnemonic != "jmp" || !is_jump(out[p - 1]) || out[p - 1].mnemonic == "jmp")
+	{
+		return false;
+	}
+	if (out[p - 1].operands[0] != out[n - 1].mnemonic)
+	{
+		return false;
+	}
+	out[p - 1].mnemonic = InstructionSelector::invert_jump(out[p - 1].mnemonic);
+	out[p - 1].operands[0] = out[p].operands[0];
+	out.erase(out.begin() + p);
+	return true;
+}
+
+bool Peephole::boolean_normalization(vector<MachineInstr> &out)
+{
+	int n = out.size();
+	if (n < 4 || out[n - 1].kind != MachineInstr::instruction || out[n - 2].kind != MachineInstr::instruction)
+	{
+		return false;
+	}
+	string &use = out[n - 1].mnemonic;
+	if (use != "sete" && use != "setne" && use != "je" && use != "jne")
+	{
+		return false;
+	}
+	// Test à zéro du booléen X
+	MachineInstr &test = out[n - 2];
+	string tested;
+	if (test.mnemonic == "testl" && test.operands[0] == test.operands[1])
+	{
+		tested = test.operands[0];
+	}
+	else if (test.mnemonic == "cmpl" && test.operands[0] == "$0")
+	{
+		tested = test.operands[1];
+	}
+	else
+	{
+		return false;
+	}
+
+	// Le setcc qui l'a produit, séparé du test par des copies (qui ne touchent pas aux drapeaux)
+	int k = n - 3;
+	while (k >= 0 && k >= n - 8 && out[k].kind == MachineInstr::instruction && (out[k].mnemonic == "movl" || out[k].mnemonic == "movzbl"))
+	{
+		k--;
+	}
+	if (k < 0 || out[k].kind != MachineInstr::instruction || out[k].mnemonic.compare(0, 3, "set") != 0 || out[k].operands[0] != "%al")
+	{
+		return false;
+	}
+	set<string> holdsCondition = {"%al"};
+	for (int i = k + 1; i < n - 2; i++)
+	{
+		const string &source = out[i].operands[0];
+		const string &dest = out[i].operands[1];
+		if (holdsCondition.count(source))
+		{
+			holdsCondition.insert(dest);
+		}
+		else
+		{
+			holdsCondition.erase(dest);
+			if (dest == "%eax")
+			{
+				holdsCondition.erase("%al");
+			}
+		}
+	}
+	if (!holdsCondition.count(tested))
+	{
+		return false;
+	}
+
+	// X vaut 1 exactement quand cc est vraie : X == 0 équivaut à la condition inverse
+	string cc = out[k].mnemonic.substr(3);
+	bool isZero = use == "sete" || use == "je";
+	string condition = isZero ? InstructionSelector::invert_condition(cc) : cc;
+	out[n - 1].mnemonic = (use[0] == 'j' ? "j" : "set") + condition;
+	out.erase(out.begin() + n - 2);
+	return true;
+}
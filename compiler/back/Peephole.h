@@ -0,0 +1,64 @@
+#ifndef PEEPHOLE_H
+#define PEEPHOLE_H
+
+#include <vector>
+#include <string>
+#include <utility>
+
+#include "MachineCode.h"
+
+using namespace std;
+
+/** Optimisation à lucarne (peephole) sur le code x86 d'une fonction.
+
+	Les instructions sont recopiées une à une ; après chaque ajout, les règles regardent la fin du
+	code déjà produit (quelques instructions) et la réécrivent, jusqu'à ce qu'aucune ne s'applique.
+	Une réécriture peut ainsi en déclencher une autre sur les instructions précédentes.
+
+	Règles :
+	- copie d'un emplacement sur lui-même (movl X, X) supprimée ;
+	- movl A, B suivi de movl B, A (ou de movl A, B) : le second est supprimé ;
+	- movl R, M suivi de movl M, S : la relecture de la case M devient movl R, S ;
+	- saut (jmp ou jcc) vers l'étiquette qui le suit immédiatement supprimé ;
+	- jcc L ; jmp M ; L: devient jncc M ; L: ;
+	- booléen normalisé deux fois : setcc %al ; movzbl %al, X ; testl X, X suivi de sete, setne,
+	  je ou jne réutilise directement la condition cc (ou son inverse), encore dans les drapeaux.
+
+	Une étiquette interrompt les règles sur les données : le code qui la suit peut être atteint
+	par un saut, avec d'autres valeurs dans les registres.
+*/
+class Peephole
+{
+public:
+	Peephole(MachineCode *code);
+
+	/** Renvoie le nombre total de réécritures */
+	int run();
+
+	/** (nom de la règle, nombre d'applications) */
+	vector<pair<string, int>> get_stats();
+
+private:
+	typedef bool (Peephole::*Rule)(vector<MachineInstr> &out);
+	struct RuleEntry
+	{
+		string name;
+		Rule apply;
+		int hits;
+	};
+
+	bool self_move(vector<MachineInstr> &out);
+	bool redundant_move(vector<MachineInstr> &out);
+	bool store_load(vector<MachineInstr> &out);
+	bool jump_to_next(vector<MachineInstr> &out);
+	bool branch_over_jump(vector<MachineInstr> &out);
+	bool boolean_normalization(vector<MachineInstr> &out);
+
+	/** Indice de la dernière instruction avant end, en sautant étiquettes et directives ; -1 sinon */
+	static int previous_instr(const vector<MachineInstr> &out, int end);
+
+	MachineCode *code;
+	vector<RuleEntry> rules;
+};
+
+#endif
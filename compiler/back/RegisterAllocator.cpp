@@ -0,0 +1,190 @@
+#include "RegisterAllocator.h"
+
+#include <algorithm>
+#include <climits>
+
+// Registres callee-saved : sauvegardés dans le prologue, ils survivent aux appels
+static const vector<pair<string, string>> calleeSaved = {
+	{"%ebx", "%rbx"}, {"%r12d", "%r12"}, {"%r13d", "%r13"}, {"%r14d", "%r14"}, {"%r15d", "%r15"}};
+// Registres caller-saved libres : gratuits, mais écrasés par un call
+static const vector<string> callerSaved = {"%r10d", "%r11d"};
+
+RegisterAllocator::RegisterAllocator(CFG *cfg, Liveness *liveness) : cfg(cfg), liveness(liveness)
+{
+	nbVars = cfg->get_nb_symbols();
+}
+
+void RegisterAllocator::run()
+{
+	number_instructions();
+	build_intervals();
+	linear_scan();
+}
+
+void RegisterAllocator::number_instructions()
+{
+	// Chaque instruction lit ses opérandes en 2k et écrit son résultat en 2k+1 :
+	// un temporaire qui meurt en étant lu peut ainsi céder son registre au résultat
+	int position = 0;
+	for (auto &bb : liveness->order)
+	{
+		blockStart.push_back(2 * position++);
+		for (auto &instr : bb->instrs)
+		{
+			if (instr->op == IRInstr::call)
+			{
+				callPositions.push_back(2 * position);
+			}
+			position++;
+		}
+		blockEnd.push_back(2 * position++);
+	}
+}
+
+void RegisterAllocator::build_intervals()
+{
+	vector<int> start(nbVars, INT_MAX);
+	vector<int> end(nbVars, -1);
+	auto extend = [&](int var, int position) {
+		if (var == -1)
+		{
+			return;
+		}
+		start[var] = min(start[var], position);
+		end[var] = max(end[var], position);
+	};
+
+	vector<BasicBlock *> &order = liveness->order;
+	for (int b = 0; b < order.size(); b++)
+	{
+		liveness->liveIn[b].for_each([&](int var) { extend(var, blockStart[b]); });
+		liveness->liveOut[b].for_each([&](int var) { extend(var, blockEnd[b]); });
+		int position = blockStart[b] + 2;
+		for (auto &instr : order[b]->instrs)
+		{
+			for (int var : instr->get_uses())
+			{
+				extend(var, position);
+			}
+			for (int var : instr->get_defs())
+			{
+				extend(var, position + 1);
+			}
+			position += 2;
+		}
+	}
+
+	// Les intervalles sont sans trous : c'est conservateur, mais suffisant pour un balayage linéaire
+	for (int var = 0; var < nbVars; var++)
+	{
+		// Une variable lue avant toute écriture (vivante à l'entrée) garde sa case mémoire,
+		// comme avant l'allocation de registres
+		// Une immédiate ou une condition restée dans les drapeaux n'occupe aucun registre
+		if (end[var] == -1 || (!order.empty() && liveness->liveIn[0][var]) || !cfg->has_location(var))
+		{
+			continue;
+		}
+		Interval interval = {var, start[var], end[var], false, ""};
+		for (int call : callPositions)
+		{
+			if (start[var] < call && end[var] > call + 1)
+			{
+				interval.crossesCall = true;
+				break;
+			}
+		}
+		intervals.push_back(interval);
+	}
+	sort(intervals.begin(), intervals.end(), [](const Interval &a, const Interval &b) {
+		return a.start < b.start;
+	});
+}
+
+void RegisterAllocator::linear_scan()
+{
+	vector<string> freeCallee, freeCaller = callerSaved;
+	for (auto &reg : calleeSaved)
+	{
+		freeCallee.push_back(reg.first);
+	}
+	auto isCalleeSaved = [](const string &reg) {
+		return find(callerSaved.begin(), callerSaved.end(), reg) == callerSaved.end();
+	};
+	auto release = [&](const string &reg) {
+		if (isCalleeSaved(reg))
+		{
+			freeCallee.push_back(reg);
+		}
+		else
+		{
+			freeCaller.push_back(reg);
+		}
+	};
+
+	vector<Interval *> active;
+	for (auto &current : intervals)
+	{
+		// On libère les registres des intervalles terminés
+		for (auto it = active.begin(); it != active.end();)
+		{
+			if ((*it)->end < current.start)
+			{
+				release((*it)->reg);
+				it = active.erase(it);
+			}
+			else
+			{
+				it++;
+			}
+		}
+
+		if (!current.crossesCall && !freeCaller.empty())
+		{
+			current.reg = freeCaller.back();
+			freeCaller.pop_back();
+		}
+		else if (!freeCallee.empty())
+		{
+			current.reg = freeCallee.front();
+			freeCallee.erase(freeCallee.begin());
+		}
+		else
+		{
+			// Pas de registre libre : on garde en mémoire l'intervalle qui se termine le plus tard
+			Interval *victim = nullptr;
+			for (auto &candidate : active)
+			{
+				if ((!current.crossesCall || isCalleeSaved(candidate->reg)) && (victim == nullptr || candidate->end > victim->end))
+				{
+					victim = candidate;
+				}
+			}
+			if (victim == nullptr || victim->end <= current.end)
+			{
+				continue;
+			}
+			current.reg = victim->reg;
+			victim->reg = "";
+			active.erase(find(active.begin(), active.end(), victim));
+		}
+		active.push_back(&current);
+	}
+
+	vector<string> usedCalleeSaved;
+	for (auto &reg : calleeSaved)
+	{
+		for (auto &interval : intervals)
+		{
+			if (interval.reg == reg.first)
+			{
+				usedCalleeSaved.push_back(reg.second);
+				break;
+			}
+		}
+	}
+	for (auto &interval : intervals)
+	{
+		cfg->set_var_register(interval.var, interval.reg);
+	}
+	cfg->set_callee_saved_registers(usedCalleeSaved);
+}
@@ -0,0 +1,53 @@
+#ifndef REGISTER_ALLOCATOR_H
+#define REGISTER_ALLOCATOR_H
+
+#include <vector>
+#include <string>
+
+#include "IR.h"
+#include "Liveness.h"
+
+using namespace std;
+
+/** Allocation de registres par balayage linéaire (linear scan) des intervalles de vie.
+
+	Les variables et temporaires d'un CFG sont placés dans les registres généraux libres
+	pendant toute leur durée de vie ; seules celles qui ne trouvent pas de registre
+	(forte pression) restent dans leur case mémoire -N(%rbp).
+
+	%eax, %edx et %ecx restent réservés aux séquences choisies par l'InstructionSelector (cltd/idivl),
+	et les registres de passage de paramètres ne sont jamais alloués, ce qui évite tout conflit
+	lors de la préparation d'un appel.
+*/
+class RegisterAllocator
+{
+public:
+	RegisterAllocator(CFG *cfg, Liveness *liveness);
+
+	/** Calcule les intervalles de vie et renseigne le CFG avec les registres choisis */
+	void run();
+
+private:
+	/** Intervalle de vie d'une variable, en positions d'instructions dans l'ordre d'émission */
+	struct Interval
+	{
+		int var;
+		int start;
+		int end;
+		bool crossesCall; /**< vivante de part et d'autre d'un call : seul un registre callee-saved convient */
+		string reg;
+	};
+
+	void number_instructions();
+	void build_intervals();
+	void linear_scan();
+
+	CFG *cfg;
+	Liveness *liveness;
+	int nbVars;
+	vector<int> blockStart, blockEnd; /**< positions de début et de fin de chaque bloc de liveness->order */
+	vector<int> callPositions;
+	vector<Interval> intervals;
+};
+
+#endif
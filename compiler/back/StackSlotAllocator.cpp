@@ -0,0 +1,124 @@
+#include "StackSlotAllocator.h"
+
+StackSlotAllocator::StackSlotAllocator(CFG *cfg, Liveness *liveness) : cfg(cfg), liveness(liveness)
+{
+	int nbVars = cfg->get_nb_symbols();
+	inMemory.assign(nbVars, false);
+	interference.assign(nbVars, unordered_set<int>());
+	for (int b = 0; b < liveness->order.size(); b++)
+	{
+		for (auto &instr : liveness->order[b]->instrs)
+		{
+			for (int var : instr->get_uses())
+			{
+				if (var != -1 && cfg->get_var_register(var) == "" && cfg->has_location(var))
+				{
+					inMemory[var] = true;
+				}
+			}
+			for (int var : instr->get_defs())
+			{
+				if (var != -1 && cfg->get_var_register(var) == "" && cfg->has_location(var))
+				{
+					inMemory[var] = true;
+				}
+			}
+		}
+	}
+	for (int var = 0; var < nbVars; var++)
+	{
+		if (inMemory[var])
+		{
+			memoryVars.push_back(var);
+		}
+	}
+}
+
+void StackSlotAllocator::run()
+{
+	build_interference();
+	color();
+}
+
+void StackSlotAllocator::build_interference()
+{
+	int nbVars = inMemory.size();
+	for (int b = 0; b < liveness->order.size(); b++)
+	{
+		// On remonte le bloc en maintenant l'ensemble des variables vivantes après chaque instruction
+		vector<bool> live(nbVars, false);
+		for (int var : memoryVars)
+		{
+			live[var] = liveness->liveOut[b][var];
+		}
+		vector<IRInstr *> &instrs = liveness->order[b]->instrs;
+		for (int i = instrs.size() - 1; i >= 0; i--)
+		{
+			vector<int> defs = instrs[i]->get_defs();
+			for (int def : defs)
+			{
+				if (def == -1 || !inMemory[def])
+				{
+					continue;
+				}
+				// Une écriture, même inutile, ne doit pas écraser une variable vivante
+				for (int var : memoryVars)
+				{
+					if (live[var] && var != def)
+					{
+						interference[def].insert(var);
+						interference[var].insert(def);
+					}
+				}
+				for (int other : defs)
+				{
+					if (other != -1 && other != def && inMemory[other])
+					{
+						interference[def].insert(other);
+					}
+				}
+			}
+			for (int def : defs)
+			{
+				if (def != -1)
+				{
+					live[def] = false;
+				}
+			}
+			for (int use : instrs[i]->get_uses())
+			{
+				if (use != -1 && inMemory[use])
+				{
+					live[use] = true;
+				}
+			}
+		}
+	}
+}
+
+void StackSlotAllocator::color()
+{
+	// Coloration gloutonne dans l'ordre de création des symboles : chaque couleur est une case de 4 octets
+	vector<int> slot(inMemory.size(), -1);
+	int nbSlots = 0;
+	for (int var : memoryVars)
+	{
+		vector<bool> taken(nbSlots + 1, false);
+		for (int neighbour : interference[var])
+		{
+			if (slot[neighbour] != -1)
+			{
+				taken[slot[neighbour]] = true;
+			}
+		}
+		int color = 0;
+		while (taken[color])
+		{
+			color++;
+		}
+		slot[var] = color;
+		nbSlots = max(nbSlots, color + 1);
+		cfg->get_symbol(var)->setOffset((color + 1) * 4);
+	}
+	cfg->set_frame_size(nbSlots * 4);
+}
@@ -0,0 +1,35 @@
+#ifndef STACK_SLOT_ALLOCATOR_H
+#define STACK_SLOT_ALLOCATOR_H
+
+#include <vector>
+#include <unordered_set>
+
+#include "IR.h"
+#include "Liveness.h"
+
+using namespace std;
+
+/** Attribution des cases mémoire -N(%rbp) par coloration du graphe d'interférence.
+
+	Seules les variables restées en mémoire après l'allocation de registres reçoivent une case ;
+	deux variables qui ne sont jamais vivantes en même temps partagent la même case.
+	La taille finale de la frame est enregistrée dans le CFG (CFG::get_frame_size).
+*/
+class StackSlotAllocator
+{
+public:
+	StackSlotAllocator(CFG *cfg, Liveness *liveness);
+	void run();
+
+private:
+	void build_interference();
+	void color();
+
+	CFG *cfg;
+	Liveness *liveness;
+	vector<bool> inMemory; /**< variables sans registre, indexées par numéro de symbole */
+	vector<int> memoryVars; /**< les mêmes, sous forme de liste */
+	vector<unordered_set<int>> interference;
+};
+
+#endif
@@ -0,0 +1,126 @@
+#include "Tracer.h"
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace
+{
+	/** Numéro du thread appelant dans la trace : 1 pour le premier thread qui trace, puis 2, 3... */
+	int thread_number()
+	{
+		static atomic<int> nextNumber(1);
+		thread_local int number = nextNumber++;
+		return number;
+	}
+
+	/** Pic de mémoire résidente du processus, en Ko */
+	long peak_rss()
+	{
+		struct rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+		return usage.ru_maxrss;
+	}
+
+	void write_json_string(ofstream &out, const string &s)
+	{
+		out << '"';
+		for (char c : s)
+		{
+			if (c == '"' || c == '\\')
+			{
+				out << '\\' << c;
+			}
+			else if ((unsigned char)c < 0x20)
+			{
+				char escaped[8];
+				snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned char)c);
+				out << escaped;
+			}
+			else
+			{
+				out << c;
+			}
+		}
+		out << '"';
+	}
+}
+
+Tracer::Tracer() : origin(chrono::steady_clock::now())
+{
+}
+
+double Tracer::now() const
+{
+	return chrono::duration<double, micro>(chrono::steady_clock::now() - origin).count();
+}
+
+void Tracer::complete(const char *name, const string *detail, bool phase, double start)
+{
+	double end = now();
+	int thread = thread_number();
+	string fullName = detail == nullptr ? string(name) : string(name) + " " + *detail;
+	lock_guard<mutex> guard(lock);
+	events.push_back({fullName, 'X', phase, thread, start, end - start, 0});
+	if (phase)
+	{
+		events.push_back({"mémoire", 'C', phase, thread, end, 0, peak_rss()});
+	}
+}
+
+bool Tracer::write(const string &path)
+{
+	ofstream out(path);
+	if (!out)
+	{
+		return false;
+	}
+	lock_guard<mutex> guard(lock);
+	int pid = getpid();
+	char number[32];
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	for (size_t i = 0; i < events.size(); i++)
+	{
+		const Event &event = events[i];
+		out << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+		write_json_string(out, event.name);
+		out << ",\"ph\":\"" << event.kind << "\",\"pid\":" << pid << ",\"tid\":" << event.thread;
+		snprintf(number, sizeof(number), "%.3f", event.start);
+		out << ",\"ts\":" << number;
+		if (event.kind == 'X')
+		{
+			snprintf(number, sizeof(number), "%.3f", event.duration);
+			out << ",\"dur\":" << number << ",\"cat\":\"" << (event.phase ? "phase" : "fonction") << "\"}";
+		}
+		else
+		{
+			out << ",\"args\":{\"pic RSS (Ko)\":" << event.peakRss << "}}";
+		}
+	}
+	out << "\n]}\n";
+	return out.good();
+}
+
+TraceSpan::TraceSpan(Tracer *tracer, const char *name, const string *detail, bool phase) : tracer(tracer), name(name), detail(detail), phase(phase), start(0)
+{
+	if (tracer != nullptr)
+	{
+		start = tracer->now();
+	}
+}
+
+TraceSpan::~TraceSpan()
+{
+	end();
+}
+
+void TraceSpan::end()
+{
+	if (tracer != nullptr)
+	{
+		tracer->complete(name, detail, phase, start);
+		tracer = nullptr;
+	}
+}
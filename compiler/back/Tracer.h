@@ -0,0 +1,71 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/** Trace de la compilation (option --trace=out.json) au format « trace event » de Chrome, lisible
+	par chrome://tracing ou Perfetto.
+
+	Chaque phase (lecture, lexer, analyse, construction de l'IR, optimisation, émission...) et chaque
+	fonction est un intervalle horodaté sur le thread qui l'a exécutée : les intervalles d'un même
+	thread s'emboîtent d'après leurs dates. La fin de chaque phase ajoute un échantillon du pic de
+	mémoire résidente du processus.
+
+	Sans --trace, aucun Tracer n'existe : les TraceSpan reçoivent nullptr et ne font qu'un test.
+*/
+class Tracer
+{
+public:
+	Tracer();
+
+	/** Microsecondes écoulées depuis la création de la trace */
+	double now() const;
+
+	/** Ajoute l'intervalle [start, maintenant] sur le thread appelant, nommé name ou « name detail ».
+		Une phase est suivie d'un échantillon de mémoire. */
+	void complete(const char *name, const string *detail, bool phase, double start);
+
+	/** Écrit la trace ; false si le fichier ne peut pas être écrit */
+	bool write(const string &path);
+
+private:
+	struct Event
+	{
+		string name;
+		char kind;		/**< 'X' : intervalle, 'C' : échantillon de mémoire */
+		bool phase;
+		int thread;
+		double start;
+		double duration;
+		long peakRss; /**< en Ko, pour un échantillon */
+	};
+
+	chrono::steady_clock::time_point origin;
+	mutex lock;
+	vector<Event> events;
+};
+
+/** Intervalle de trace limité à un bloc : commence à la construction, se termine à la destruction
+	ou à l'appel de end(). Ne fait rien si tracer est nullptr. */
+class TraceSpan
+{
+public:
+	TraceSpan(Tracer *tracer, const char *name, const string *detail = nullptr, bool phase = true);
+	~TraceSpan();
+
+	void end();
+
+private:
+	Tracer *tracer;
+	const char *name;
+	const string *detail;
+	bool phase;
+	double start;
+};
+
+#endif
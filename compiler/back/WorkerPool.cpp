@@ -0,0 +1,91 @@
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <thread>
+
+WorkerPool::WorkerPool(int nbWorkers) : nbWorkers(nbWorkers < 1 ? 1 : nbWorkers)
+{
+	for (int i = 0; i < this->nbWorkers; i++)
+	{
+		queues.push_back(make_unique<Queue>());
+	}
+}
+
+void WorkerPool::run(int count, const function<void(int)> &task)
+{
+	int workers = min(nbWorkers, count);
+	if (workers <= 1)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			task(i);
+		}
+		return;
+	}
+
+	// Tranches contiguës : les premiers threads reçoivent une tâche de plus si count ne tombe pas juste
+	int next = 0;
+	for (int w = 0; w < workers; w++)
+	{
+		int share = count / workers + (w < count % workers ? 1 : 0);
+		for (int i = 0; i < share; i++)
+		{
+			queues[w]->tasks.push_back(next++);
+		}
+	}
+
+	vector<thread> threads;
+	for (int w = 1; w < workers; w++)
+	{
+		threads.emplace_back(&WorkerPool::work, this, w, cref(task));
+	}
+	work(0, task);
+	for (auto &t : threads)
+	{
+		t.join();
+	}
+}
+
+int WorkerPool::get_nb_workers()
+{
+	return nbWorkers;
+}
+
+void WorkerPool::work(int worker, const function<void(int)> &task)
+{
+	// Aucune tâche n'est ajoutée pendant run : quand toutes les files sont vides, il n'y a plus rien à faire
+	int current;
+	while (pop(worker, current) || steal(worker, current))
+	{
+		task(current);
+	}
+}
+
+bool WorkerPool::pop(int worker, int &task)
+{
+	Queue &queue = *queues[worker];
+	lock_guard<mutex> guard(queue.lock);
+	if (queue.tasks.empty())
+	{
+		return false;
+	}
+	task = queue.tasks.front();
+	queue.tasks.pop_front();
+	return true;
+}
+
+bool WorkerPool::steal(int worker, int &task)
+{
+	for (int i = 1; i < nbWorkers; i++)
+	{
+		Queue &victim = *queues[(worker + i) % nbWorkers];
+		lock_guard<mutex> guard(victim.lock);
+		if (!victim.tasks.empty())
+		{
+			task = victim.tasks.back();
+			victim.tasks.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,45 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+/** Pool de threads à vol de tâches, utilisé pour compiler les fonctions en parallèle (-j N).
+
+	Les tâches sont des numéros de 0 à count - 1, répartis au départ en tranches contiguës : chaque
+	thread prend les siennes dans l'ordre, par le début de sa file. Un thread qui a vidé sa file
+	vole la dernière tâche d'un autre, ce qui rééquilibre la charge quand quelques fonctions sont
+	beaucoup plus longues à compiler que les autres.
+*/
+class WorkerPool
+{
+public:
+	WorkerPool(int nbWorkers);
+
+	/** Exécute task(i) pour chaque i de 0 à count - 1 et rend la main quand toutes sont terminées.
+		Le thread appelant travaille avec les autres. */
+	void run(int count, const function<void(int)> &task);
+
+	int get_nb_workers();
+
+private:
+	struct Queue
+	{
+		mutex lock;
+		deque<int> tasks;
+	};
+
+	bool pop(int worker, int &task);   /**< prochaine tâche de la file du thread */
+	bool steal(int worker, int &task); /**< dernière tâche de la file d'un autre thread */
+	void work(int worker, const function<void(int)> &task);
+
+	int nbWorkers;
+	vector<unique_ptr<Queue>> queues;
+};
+
+#endif
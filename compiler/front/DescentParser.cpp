@@ -0,0 +1,428 @@
+#include "DescentParser.h"
+
+#include <unordered_set>
+
+DescentParser::DescentParser(Arena *arena, Interner *interner, Tracer *tracer) : generator(arena, interner, tracer), tracer(tracer), scanner(nullptr), log(nullptr), cursor(0), failed(false), duplicateParams(0)
+{
+}
+
+list<CFG *> *DescentParser::parse(const char *data, size_t size, ostream &log)
+{
+	TraceSpan lexing(tracer, "lexer");
+	Scanner tokens(data, size);
+	tokens.run(log);
+	lexing.end();
+	TraceSpan parsing(tracer, "analyse et construction de l'IR");
+	scanner = &tokens;
+	this->log = &log;
+	cursor = 0;
+	failed = false;
+	duplicate.clear();
+
+	generator.begin_program(log);
+	declare_functions();
+
+	// prog : (function)+ ; axiom ne se termine pas par EOF : ce qui suit la dernière fonction est ignoré
+	if (peek() != TokenKind::kw_int)
+	{
+		error("'int'");
+	}
+	while (peek() == TokenKind::kw_int)
+	{
+		parse_function();
+	}
+	scanner = nullptr;
+	if (failed)
+	{
+		return nullptr;
+	}
+	// Comme buildIR, une fonction définie deux fois fait échouer le fichier (end_program rend nullptr),
+	// mais n'est signalée qu'en l'absence d'erreur de syntaxe
+	if (!duplicate.empty())
+	{
+		generator.declare_function(duplicate, duplicateParams);
+	}
+	return generator.end_program();
+}
+
+bool DescentParser::has_syntax_error() const
+{
+	return failed;
+}
+
+void DescentParser::declare_functions()
+{
+	// Premier passage sur les en-têtes : le corps de chaque fonction est sauté grâce à l'accolade appariée
+	vector<ScanToken> &tokens = scanner->tokens;
+	unordered_set<string> names;
+	int i = 0;
+	while (tokens[i].kind == TokenKind::kw_int && tokens[i + 1].kind == TokenKind::name && tokens[i + 2].kind == TokenKind::lparen)
+	{
+		int close = tokens[i + 2].partner;
+		if (close == -1 || tokens[close + 1].kind != TokenKind::lbrace || tokens[close + 1].partner == -1)
+		{
+			break;
+		}
+		int nbParams = 0;
+		for (int j = i + 3; j < close; j++)
+		{
+			nbParams += tokens[j].kind == TokenKind::name ? 1 : 0;
+		}
+		string name = scanner->text(tokens[i + 1]);
+		if (names.insert(name).second)
+		{
+			generator.declare_function(name, nbParams);
+		}
+		else if (duplicate.empty())
+		{
+			duplicate = name;
+			duplicateParams = nbParams;
+		}
+		i = tokens[close + 1].partner + 1;
+	}
+}
+
+void DescentParser::parse_function()
+{
+	// function : 'int' VARNAME '(' params? ')' '{' (statement)* '}'
+	int line = next().line;
+	string name = peek() == TokenKind::name ? scanner->text(scanner->tokens[cursor]) : "";
+	expect(TokenKind::name, "a function name");
+	expect(TokenKind::lparen, "'('");
+	vector<string> params;
+	if (peek() == TokenKind::kw_int)
+	{
+		do
+		{
+			expect(TokenKind::kw_int, "'int'");
+			if (peek() == TokenKind::name)
+			{
+				params.push_back(scanner->text(scanner->tokens[cursor]));
+			}
+			expect(TokenKind::name, "a parameter name");
+		} while (peek() == TokenKind::comma && next().kind == TokenKind::comma);
+	}
+	expect(TokenKind::rparen, "')'");
+	generator.begin_function(name, params, line);
+	expect(TokenKind::lbrace, "'{'");
+	while (peek() != TokenKind::rbrace && peek() != TokenKind::end)
+	{
+		parse_statement();
+	}
+	expect(TokenKind::rbrace, "'}'");
+	generator.end_function();
+}
+
+void DescentParser::parse_statement()
+{
+	switch (peek())
+	{
+		case TokenKind::kw_int:
+			parse_int_statement();
+			break;
+		case TokenKind::kw_return:
+		{
+			next();
+			int var = parse_expr(1);
+			generator.ret(var);
+			expect(TokenKind::semicolon, "';'");
+			break;
+		}
+		case TokenKind::name:
+			if (peek(1) == TokenKind::assign)
+			{
+				// definition : VARNAME '=' expr
+				const ScanToken &target = next();
+				int var = generator.assign_target(scanner->text(target), target.line);
+				next();
+				int value = parse_expr(1);
+				generator.assign(var, value);
+			}
+			else if (peek(1) == TokenKind::lparen)
+			{
+				parse_call();
+			}
+			else
+			{
+				next();
+				error("'=' or '('");
+			}
+			expect(TokenKind::semicolon, "';'");
+			break;
+		case TokenKind::lbrace:
+			parse_block();
+			break;
+		case TokenKind::kw_if:
+			parse_if();
+			break;
+		case TokenKind::kw_while:
+			parse_while();
+			break;
+		default:
+			error("a statement");
+			break;
+	}
+}
+
+void DescentParser::parse_int_statement()
+{
+	// declaration : 'int' VARNAME (',' VARNAME)* ; suivie de '=' expr, c'est une definition
+	vector<ScanToken> &tokens = scanner->tokens;
+	int line = next().line;
+	int first = cursor;
+	if (peek() != TokenKind::name)
+	{
+		error("a variable name");
+		return;
+	}
+	int last = first;
+	while (tokens[last + 1].kind == TokenKind::comma && tokens[last + 2].kind == TokenKind::name)
+	{
+		last += 2;
+	}
+	cursor = last + 1;
+	if (peek() == TokenKind::assign)
+	{
+		// Comme buildIR::visitDeclpartg, seule la première variable est définie
+		int var = generator.define(scanner->text(tokens[first]), line);
+		next();
+		int value = parse_expr(1);
+		generator.assign(var, value);
+	}
+	else
+	{
+		for (int i = first; i <= last; i += 2)
+		{
+			generator.declare(scanner->text(tokens[i]), line);
+		}
+	}
+	expect(TokenKind::semicolon, "';'");
+}
+
+void DescentParser::parse_block()
+{
+	if (!expect(TokenKind::lbrace, "'{'"))
+	{
+		return;
+	}
+	int initialScope = generator.begin_block();
+	while (peek() != TokenKind::rbrace && peek() != TokenKind::end)
+	{
+		parse_statement();
+	}
+	expect(TokenKind::rbrace, "'}'");
+	generator.end_block(initialScope);
+}
+
+void DescentParser::parse_if()
+{
+	// blockif : 'if' '(' expr ')' block (blockelse)?
+	next();
+	expect(TokenKind::lparen, "'('");
+	int comp = parse_expr(1);
+	expect(TokenKind::rparen, "')'");
+	if (peek() != TokenKind::lbrace || scanner->tokens[cursor].partner == -1)
+	{
+		error("'{'");
+		return;
+	}
+	int thenStart = cursor;
+	int thenEnd = scanner->tokens[cursor].partner;
+	bool hasElse = scanner->tokens[thenEnd + 1].kind == TokenKind::kw_else;
+
+	// buildIR construit le else avant le then : on saute le then, puis on y revient
+	IRGenerator::IfBlocks blocks = generator.begin_if(comp, hasElse);
+	int after = thenEnd + 1;
+	if (hasElse)
+	{
+		cursor = thenEnd + 2;
+		parse_block();
+		after = cursor;
+		generator.end_else(blocks);
+		cursor = thenStart;
+	}
+	generator.begin_then(blocks);
+	parse_block();
+	cursor = after;
+	generator.end_if(blocks);
+}
+
+void DescentParser::parse_while()
+{
+	// blockwhile : 'while' '(' expr ')' block
+	next();
+	IRGenerator::WhileBlocks blocks = generator.begin_while();
+	expect(TokenKind::lparen, "'('");
+	int comp = parse_expr(1);
+	expect(TokenKind::rparen, "')'");
+	generator.begin_while_body(blocks, comp);
+	parse_block();
+	generator.end_while(blocks);
+}
+
+int DescentParser::precedence(TokenKind kind)
+{
+	// Même ordre que les alternatives de expr dans ifcc.g4 : la première est la plus prioritaire
+	switch (kind)
+	{
+		case TokenKind::star:
+		case TokenKind::slash:
+			return 4;
+		case TokenKind::plus:
+		case TokenKind::minus:
+			return 3;
+		case TokenKind::less:
+		case TokenKind::greater:
+			return 2;
+		case TokenKind::equal:
+		case TokenKind::notequal:
+			return 1;
+		default:
+			return 0;
+	}
+}
+
+int DescentParser::parse_expr(int minPrecedence)
+{
+	// Montée de précédence : les opérateurs binaires sont associatifs à gauche. La ligne d'une opération
+	// est celle du premier jeton de son opérande gauche, comme getStart() pour buildIR
+	int line = scanner->tokens[cursor].line;
+	int left = parse_primary();
+	int prec;
+	while ((prec = precedence(peek())) >= minPrecedence && prec > 0)
+	{
+		string op = scanner->text(next());
+		int right = parse_expr(prec + 1);
+		left = generator.binary(op, left, right, line);
+	}
+	return left;
+}
+
+int DescentParser::parse_primary()
+{
+	const ScanToken &token = scanner->tokens[cursor];
+	switch (peek())
+	{
+		case TokenKind::bang:
+		case TokenKind::minus:
+		{
+			// L'opérateur unaire est le plus prioritaire : son opérande ne contient aucune opération binaire
+			next();
+			int operand = parse_primary();
+			return generator.unary(scanner->text(token)[0], operand, token.line);
+		}
+		case TokenKind::constant:
+			next();
+			return generator.constant(scanner->text(token));
+		case TokenKind::name:
+			if (peek(1) == TokenKind::lparen)
+			{
+				return parse_call();
+			}
+			next();
+			return generator.variable(scanner->text(token), token.line);
+		case TokenKind::lparen:
+		{
+			next();
+			int var = parse_expr(1);
+			expect(TokenKind::rparen, "')'");
+			return var;
+		}
+		default:
+			error("an expression");
+			return -1;
+	}
+}
+
+int DescentParser::parse_call()
+{
+	// functionCall : VARNAME '(' (expr (',' expr)*)? ')'
+	const ScanToken &callee = next();
+	string name = scanner->text(callee);
+	// buildIR connaît le nombre d'arguments avant de les évaluer : on les compte sans les analyser
+	int result = generator.begin_call(name, count_arguments(cursor), callee.line);
+	expect(TokenKind::lparen, "'('");
+	vector<int> args;
+	if (peek() != TokenKind::rparen)
+	{
+		args.push_back(parse_expr(1));
+		while (peek() == TokenKind::comma)
+		{
+			next();
+			args.push_back(parse_expr(1));
+		}
+	}
+	expect(TokenKind::rparen, "')'");
+	generator.end_call(result, name, args);
+	return result;
+}
+
+int DescentParser::count_arguments(int lparen)
+{
+	vector<ScanToken> &tokens = scanner->tokens;
+	if (tokens[lparen].kind != TokenKind::lparen || tokens[lparen].partner == -1)
+	{
+		return 0;
+	}
+	int close = tokens[lparen].partner;
+	if (close == lparen + 1)
+	{
+		return 0;
+	}
+	int count = 1;
+	for (int i = lparen + 1; i < close; i++)
+	{
+		if (tokens[i].kind == TokenKind::lparen && tokens[i].partner != -1)
+		{
+			i = tokens[i].partner;
+		}
+		else if (tokens[i].kind == TokenKind::comma)
+		{
+			count++;
+		}
+	}
+	return count;
+}
+
+TokenKind DescentParser::peek(int offset)
+{
+	if (failed || cursor + offset >= scanner->tokens.size())
+	{
+		return TokenKind::end;
+	}
+	return scanner->tokens[cursor + offset].kind;
+}
+
+const ScanToken &DescentParser::next()
+{
+	const ScanToken &token = scanner->tokens[cursor];
+	if (token.kind != TokenKind::end)
+	{
+		cursor++;
+	}
+	return token;
+}
+
+bool DescentParser::expect(TokenKind kind, const char *what)
+{
+	if (peek() == kind)
+	{
+		next();
+		return true;
+	}
+	error(what);
+	return false;
+}
+
+void DescentParser::error(const string &expected)
+{
+	// Seule la première erreur est signalée : ensuite peek() rend end et l'analyse se termine
+	if (failed)
+	{
+		return;
+	}
+	const ScanToken &token = scanner->tokens[cursor];
+	string found = token.kind == TokenKind::end ? "<EOF>" : "'" + scanner->text(token) + "'";
+	*log << "line " << token.line << ":" << token.column << " syntax error at " << found << ", expecting " << expected << endl;
+	failed = true;
+}
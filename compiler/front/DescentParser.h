@@ -0,0 +1,66 @@
+#ifndef DESCENT_PARSER_H
+#define DESCENT_PARSER_H
+
+#include <iostream>
+#include <list>
+#include <string>
+
+#include "../back/IR.h"
+#include "IRGenerator.h"
+#include "Scanner.h"
+
+using namespace std;
+
+/** Front-end écrit à la main (option --frontend=rd) : analyse descendante récursive de la
+	grammaire ifcc.g4, précédence des opérateurs comprise, sans construire d'arbre.
+
+	Chaque construction reconnue est aussitôt confiée à IRGenerator, dans l'ordre où buildIR la
+	visite : les CFG sont identiques à ceux du front-end ANTLR. Deux écarts avec l'ordre du texte
+	sont nécessaires et obtenus en se déplaçant dans le tableau de jetons :
+	- la table des fonctions est remplie par un premier passage sur les seules en-têtes ;
+	- le else d'un if est construit avant son then, comme dans buildIR::visitBlockif.
+*/
+class DescentParser
+{
+public:
+	/** Les CFG sont alloués dans arena, les identificateurs internés dans interner. tracer, s'il est
+		donné, reçoit le lexer, l'analyse et la construction de chaque fonction */
+	DescentParser(Arena *arena, Interner *interner, Tracer *tracer = nullptr);
+
+	/** Analyse le texte et construit les CFG ; nullptr après une erreur de syntaxe ou une fonction
+		définie deux fois, signalées sur log */
+	list<CFG *> *parse(const char *data, size_t size, ostream &log);
+
+	bool has_syntax_error() const; /**< distingue les deux échecs de parse() */
+
+private:
+	void declare_functions();
+	void parse_function();
+	void parse_statement();
+	void parse_block();
+	void parse_if();
+	void parse_while();
+	void parse_int_statement();
+	int parse_expr(int minPrecedence);
+	int parse_primary();
+	int parse_call();
+
+	static int precedence(TokenKind kind); /**< précédence d'un opérateur binaire, 0 pour un autre jeton */
+	int count_arguments(int lparen);	   /**< nombre d'arguments de l'appel qui s'ouvre sur ce jeton */
+
+	TokenKind peek(int offset = 0); /**< end après une erreur : toutes les boucles s'arrêtent */
+	const ScanToken &next();		/**< jeton courant, puis avance */
+	bool expect(TokenKind kind, const char *what);
+	void error(const string &expected);
+
+	IRGenerator generator;
+	Tracer *tracer;
+	Scanner *scanner;
+	ostream *log;
+	int cursor;
+	bool failed;
+	string duplicate; /**< première fonction définie deux fois */
+	int duplicateParams;
+};
+
+#endif
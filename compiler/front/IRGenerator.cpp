@@ -0,0 +1,416 @@
+#include "IRGenerator.h"
+
+IRGenerator::IRGenerator(Arena *arena, Interner *interner, Tracer *tracer) : arena(arena), interner(interner), cfgs(nullptr), log(nullptr), redefinition(false), currentCFG(nullptr), countBlock(0), countReturn(0), currentEpilogue(nullptr), symbols(interner), tracer(tracer), functionStart(0)
+{
+}
+
+void IRGenerator::begin_program(ostream &log)
+{
+	// Initialisation du vecteur de CFG et de la table des fonctions
+	cfgs = arena->make<list<CFG *>>();
+	functionTable = map<string, int>();
+	this->log = &log;
+	redefinition = false;
+}
+
+bool IRGenerator::declare_function(const string &name, int nbParams)
+{
+	if (functionTable.find(name) == functionTable.end())
+	{
+		functionTable.insert(pair<string, int>(name, nbParams));
+		return true;
+	}
+	// Erreur du fichier seulement : le pilote continue avec les fichiers suivants
+	*log << "Redéfinition de la fonction " << name << endl;
+	redefinition = true;
+	return false;
+}
+
+list<CFG *> *IRGenerator::end_program()
+{
+	return redefinition ? nullptr : cfgs;
+}
+
+void IRGenerator::begin_function(const string &name, const vector<string> &params, size_t line)
+{
+	if (tracer != nullptr)
+	{
+		functionStart = tracer->now();
+	}
+	// On crée un CFG pour chaque fonction
+	CFG *cfg = arena->make<CFG>(interner);
+	cfg->label = name;
+	countBlock = 1;
+	countReturn = 0;
+	cfg->currentScope = countBlock;
+
+	// On crée un basic block pour le prologue, le corps de la fonction et l'épilogue
+	BasicBlock *prologue = cfg->create_bb("prologue", cfg->currentScope);
+	BasicBlock *bb = cfg->create_bb(name, cfg->currentScope);
+	BasicBlock *epilogue = cfg->create_bb("epilogue", cfg->currentScope);
+
+	prologue->exit_true = bb;
+	prologue->exit_false = nullptr;
+
+	bb->exit_true = epilogue;
+	bb->exit_false = nullptr;
+
+	epilogue->exit_true = nullptr;
+	epilogue->exit_false = nullptr;
+
+	cfg->add_bb(prologue);
+	cfg->add_bb(bb);
+	cfg->add_bb(epilogue);
+	currentEpilogue = epilogue;
+
+	// On mets à jour le pointeur sur le basic block actuel avec le BB correspondant au corps de la fonction
+	cfg->current_bb = bb;
+	currentCFG = cfg;
+
+	// On ouvre la portée initiale : les symboles de la fonction sont créés dans son CFG
+	symbols.begin_function(cfg);
+	symbols.open_scope();
+
+	// On ajoute à la table des symboles les paramètres de la fonction
+	if (!params.empty())
+	{
+		vector<IROperand> operands;
+		for (auto &id : params)
+		{
+			// Les paramètres d'une fonction sont forcément initialisés
+			int param = symbols.declare(id, "int", true);
+			if (param == -1)
+			{
+				cfg->add_error("Le paramètre " + id + " a été redeclaré. (ligne " + to_string(line) + ")\n");
+			}
+			operands.push_back(IROperand::variable(param));
+		}
+		// On ajoute une instruction IR qui permet d'initialiser les valeurs des paramètres passées à l'appel
+		bb->add_IRInstr(IRInstr::Operation::function_params_initialisation, "int", move(operands), currentCFG->currentScope);
+	}
+
+	// On ajoute le cfg construit à la liste des CFGs du programme
+	cfgs->push_back(cfg);
+}
+
+void IRGenerator::end_function()
+{
+	symbols.close_scope();
+	if (tracer != nullptr)
+	{
+		tracer->complete("CFG", &currentCFG->label, false, functionStart);
+	}
+}
+
+bool IRGenerator::check_initialized(int var, size_t line)
+{
+	// Une variable non déclarée a déjà été signalée par variable()
+	if (var != -1 && !currentCFG->get_symbol(var)->isInitialized())
+	{
+		currentCFG->add_error("La variable " + currentCFG->get_symbol(var)->getName() + " n'est pas initialisée. (ligne " + to_string(line) + ")\n");
+		return false;
+	}
+	return true;
+}
+
+void IRGenerator::declare(const string &name, size_t line)
+{
+	// La déclaration échoue si la variable a déjà été déclarée dans la portée actuelle
+	if (symbols.declare(name, "int", false) == -1)
+	{
+		// La variable a déjà été déclarée, il faut lever une erreur de redéclaration
+		currentCFG->add_error("La variable " + name + " a été redeclarée. (ligne " + to_string(line) + ")\n");
+	}
+}
+
+int IRGenerator::define(const string &name, size_t line)
+{
+	int var = symbols.declare(name, "int", true);
+	if (var == -1)
+	{
+		// La variable a déjà été déclarée, il faut lever une erreur de redéclaration
+		currentCFG->add_error("La variable " + name + " a été redeclarée. (ligne " + to_string(line) + ")\n");
+	}
+	return var;
+}
+
+int IRGenerator::assign_target(const string &name, size_t line)
+{
+	int var = symbols.resolve(name);
+	if (var != -1)
+	{
+		// Si la variable n'a pas encore été initialisée, on l'initialise
+		currentCFG->get_symbol(var)->setInitialized(true);
+	}
+	else
+	{
+		// La variable en partie gauche n'est pas déclarée, on lève une erreur
+		currentCFG->add_error("La variable " + name + " n'est pas déclarée. (ligne " + to_string(line) + ")\n");
+	}
+	return var;
+}
+
+int IRGenerator::assign(int var, int value)
+{
+	currentCFG->current_bb->add_IRInstr(IRInstr::Operation::copy, "int", {IROperand::variable(var), IROperand::variable(value)}, currentCFG->current_bb->scope);
+	return var;
+}
+
+int IRGenerator::ret(int var)
+{
+	currentCFG->current_bb->add_IRInstr(IRInstr::Operation::ret, "int", {IROperand::variable(var)}, currentCFG->currentScope);
+
+	// Le return termine le basic block : il mène directement à l'épilogue. Les instructions qui le suivent
+	// sont placées dans un nouveau basic block, jamais atteint, qui reprend les sorties du bloc actuel
+	countReturn++;
+	BasicBlock *afterReturn = currentCFG->create_bb(currentCFG->label + "_afterreturn" + to_string(countReturn), currentCFG->current_bb->scope);
+	afterReturn->exit_true = currentCFG->current_bb->exit_true;
+	afterReturn->exit_false = currentCFG->current_bb->exit_false;
+	currentCFG->current_bb->exit_true = currentEpilogue;
+	currentCFG->current_bb->exit_false = nullptr;
+	currentCFG->add_bb(afterReturn);
+	currentCFG->current_bb = afterReturn;
+	return var;
+}
+
+int IRGenerator::constant(const string &text)
+{
+	int tmp = currentCFG->create_new_temp("tmp");
+	currentCFG->current_bb->add_IRInstr(IRInstr::Operation::ldconst, "int", {IROperand::variable(tmp), IROperand::constant(stoi(text))}, currentCFG->currentScope);
+	return tmp;
+}
+
+int IRGenerator::variable(const string &name, size_t line)
+{
+	// Le nom est résolu ici une fois pour toutes : les instructions ne désignent que le numéro du symbole
+	int var = symbols.resolve(name);
+	if (var == -1)
+	{
+		currentCFG->add_error("La variable " + name + " n'est pas déclarée. (ligne " + to_string(line) + ")\n");
+	}
+	return var;
+}
+
+int IRGenerator::binary(const string &op, int left, int right, size_t line)
+{
+	// On vérifie que les opérandes sont initialisées, sinon on lève une erreur
+	if (check_initialized(left, line))
+	{
+		check_initialized(right, line);
+	}
+
+	// On crée une variable temporaire qui stockera le résultat de l'opération
+	int var = currentCFG->create_new_temp("tmp");
+
+	// a > b est calculé comme b < a
+	IRInstr::Operation operation;
+	if (op == "+")
+	{
+		operation = IRInstr::Operation::add;
+	}
+	else if (op == "-")
+	{
+		operation = IRInstr::Operation::sub;
+	}
+	else if (op == "*")
+	{
+		operation = IRInstr::Operation::mul;
+	}
+	else if (op == "/")
+	{
+		operation = IRInstr::Operation::div;
+	}
+	else if (op == "==")
+	{
+		operation = IRInstr::Operation::cmp_eq;
+	}
+	else if (op == "!=")
+	{
+		operation = IRInstr::Operation::cmp_ne;
+	}
+	else
+	{
+		operation = IRInstr::Operation::cmp_lt;
+		if (op == ">")
+		{
+			swap(left, right);
+		}
+	}
+	currentCFG->current_bb->add_IRInstr(operation, "int", {IROperand::variable(var), IROperand::variable(left), IROperand::variable(right)}, currentCFG->currentScope);
+	return var;
+}
+
+int IRGenerator::unary(char op, int operand, size_t line)
+{
+	// On vérifie que l'opérande est initialisée, sinon on lève une erreur
+	check_initialized(operand, line);
+
+	int var = currentCFG->create_new_temp("tmp");
+	if (op == '-')
+	{
+		currentCFG->current_bb->add_IRInstr(IRInstr::Operation::copy_neg, "int", {IROperand::variable(var), IROperand::variable(operand)}, currentCFG->currentScope);
+	}
+	else
+	{
+		currentCFG->current_bb->add_IRInstr(IRInstr::Operation::copy_not, "int", {IROperand::variable(var), IROperand::variable(operand)}, currentCFG->currentScope);
+	}
+	return var;
+}
+
+int IRGenerator::begin_call(const string &name, int nbArgs, size_t line)
+{
+	/*	Avant d'appeler la fonction, il faut vérifier qu'elle existe.
+
+		Comme on ne gère pas pour l'instant les appels de fonctions des librairies, on ne vérifera pas
+		que les fonctions appelées sont bien définies dans la classe avant l'appel, notamment pour garder
+		l'illustration de l'appel à la méthode putchar fonctionnel
+
+		Nous ne gérons pas non plus les variables globales. Ainsi, une déclaration anticipée de variables/fonction
+		ne marchera pas.
+
+		Cependant, si la fonction appelée est connue (i.e. dans la table des fonctions), on vérifie bien que l'appel est réalisé avec le bon
+		nombre de paramètres
+
+		Les arguments à partir du septième sont passés sur la pile (voir FrameLayout)
+	*/
+	int var = currentCFG->create_new_temp("tmp");
+	if (functionTable.find(name) != functionTable.end())
+	{
+		if (functionTable.at(name) > 0)
+		{
+			if (nbArgs < functionTable.at(name))
+			{
+				currentCFG->add_error("La fonction " + name + " a été appelée avec pas assez d'argument. (" + to_string(functionTable.at(name)) + " arguments attendus mais seulement " + to_string(nbArgs) + " ont été passés) (ligne " + to_string(line) + ")\n");
+			}
+			else if (nbArgs > functionTable.at(name))
+			{
+				currentCFG->add_error("La fonction " + name + " a été appelée avec trop d'argument. (" + to_string(functionTable.at(name)) + " arguments attendus mais " + to_string(nbArgs) + " ont été passés) (ligne " + to_string(line) + ")\n");
+			}
+		}
+	}
+	return var;
+}
+
+void IRGenerator::end_call(int result, const string &name, const vector<int> &args)
+{
+	vector<IROperand> params;
+	params.push_back(IROperand::variable(result));
+	params.push_back(IROperand::function(currentCFG->intern(name)));
+	for (int arg : args)
+	{
+		params.push_back(IROperand::variable(arg));
+	}
+	currentCFG->current_bb->add_IRInstr(IRInstr::Operation::call, "int", move(params), currentCFG->currentScope);
+}
+
+int IRGenerator::begin_block()
+{
+	int initialScope = currentCFG->current_bb->scope;
+	countBlock++;
+	int newScope = countBlock;
+	// On crée un nouveau niveau de portée
+	currentCFG->currentScope = newScope;
+	currentCFG->current_bb->scope = newScope;
+	// Les déclarations du bloc masquent celles des portées englobantes jusqu'à sa fin
+	symbols.open_scope();
+	return initialScope;
+}
+
+void IRGenerator::end_block(int initialScope)
+{
+	// On revient à la portée initiale
+	symbols.close_scope();
+	currentCFG->currentScope = initialScope;
+	currentCFG->current_bb->scope = initialScope;
+}
+
+IRGenerator::IfBlocks IRGenerator::begin_if(int comp, bool hasElse)
+{
+	// La condition est évaluée dans le basic block actuel
+	currentCFG->current_bb->add_IRInstr(IRInstr::Operation::if_comp, "int", {IROperand::variable(comp)}, currentCFG->currentScope);
+
+	// On crée la structure de Basic Block qui correspond au if
+	string thenLabel = "then" + to_string(countBlock);
+	string elseLabel = "else" + to_string(countBlock);
+	string endifLabel = "endif" + to_string(countBlock);
+	IfBlocks blocks;
+	blocks.then = currentCFG->create_bb(thenLabel, currentCFG->currentScope);
+	blocks.elsebb = nullptr;
+	blocks.endif = currentCFG->create_bb(endifLabel, currentCFG->currentScope);
+
+	// On chaîne les basic blocks entre eux : sans else, une condition fausse mène directement à endif
+	blocks.endif->exit_true = currentCFG->current_bb->exit_true;
+	blocks.endif->exit_false = currentCFG->current_bb->exit_false;
+	currentCFG->current_bb->exit_true = blocks.then;
+	currentCFG->current_bb->exit_false = blocks.endif;
+	blocks.then->exit_true = blocks.endif;
+	blocks.then->exit_false = nullptr;
+	currentCFG->add_bb(blocks.then);
+	currentCFG->add_bb(blocks.endif);
+	if (hasElse)
+	{
+		blocks.elsebb = currentCFG->create_bb(elseLabel, currentCFG->currentScope);
+		blocks.elsebb->exit_true = blocks.endif;
+		blocks.elsebb->exit_false = nullptr;
+		currentCFG->current_bb->exit_false = blocks.elsebb;
+		currentCFG->current_bb = blocks.elsebb;
+	}
+	return blocks;
+}
+
+void IRGenerator::end_else(IfBlocks &blocks)
+{
+	currentCFG->add_bb(blocks.elsebb);
+}
+
+void IRGenerator::begin_then(IfBlocks &blocks)
+{
+	currentCFG->current_bb = blocks.then;
+}
+
+void IRGenerator::end_if(IfBlocks &blocks)
+{
+	currentCFG->current_bb = blocks.endif;
+}
+
+IRGenerator::WhileBlocks IRGenerator::begin_while()
+{
+	// On crée la structure de Basic Block qui correspond au while :
+	// whilebb évalue la condition, bodybb contient le corps de la boucle et revient sur whilebb
+	string whileLabel = "while" + to_string(countBlock);
+	string bodyLabel = "bodywhile" + to_string(countBlock);
+	string endwhileLabel = "endwhile" + to_string(countBlock);
+	WhileBlocks blocks;
+	blocks.whilebb = currentCFG->create_bb(whileLabel, currentCFG->currentScope);
+	blocks.bodybb = currentCFG->create_bb(bodyLabel, currentCFG->currentScope);
+	blocks.endwhile = currentCFG->create_bb(endwhileLabel, currentCFG->currentScope);
+
+	blocks.endwhile->exit_true = currentCFG->current_bb->exit_true;
+	blocks.endwhile->exit_false = currentCFG->current_bb->exit_false;
+	currentCFG->current_bb->exit_true = blocks.whilebb;
+	currentCFG->current_bb->exit_false = nullptr;
+	// Si la condition est fausse, on sort de la boucle
+	blocks.whilebb->exit_true = blocks.bodybb;
+	blocks.whilebb->exit_false = blocks.endwhile;
+	blocks.bodybb->exit_true = blocks.whilebb;
+	blocks.bodybb->exit_false = nullptr;
+
+	currentCFG->add_bb(blocks.whilebb);
+	currentCFG->add_bb(blocks.bodybb);
+	currentCFG->add_bb(blocks.endwhile);
+
+	// La condition est évaluée dans whilebb
+	currentCFG->current_bb = blocks.whilebb;
+	return blocks;
+}
+
+void IRGenerator::begin_while_body(WhileBlocks &blocks, int comp)
+{
+	currentCFG->current_bb->add_IRInstr(IRInstr::Operation::if_comp, "int", {IROperand::variable(comp)}, currentCFG->currentScope);
+	currentCFG->current_bb = blocks.bodybb;
+}
+
+void IRGenerator::end_while(WhileBlocks &blocks)
+{
+	currentCFG->current_bb = blocks.endwhile;
+}
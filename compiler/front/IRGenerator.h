@@ -0,0 +1,103 @@
+#ifndef IR_GENERATOR_H
+#define IR_GENERATOR_H
+
+#include <iostream>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../back/IR.h"
+#include "SymbolTable.h"
+#include "../back/Tracer.h"
+
+using namespace std;
+
+/** Construction de l'IR à partir des constructions du langage, commune aux deux front-ends.
+
+	buildIR (visiteur de l'arbre d'ANTLR) et DescentParser (analyseur écrit à la main) appellent les
+	mêmes méthodes, dans le même ordre, pour une même construction du programme : ils produisent
+	donc les mêmes CFG, jusqu'aux numéros des symboles, aux noms des blocs et aux messages d'erreur.
+
+	Les opérandes sont désignées par le numéro de leur symbole dans le CFG courant (-1 pour une
+	variable non déclarée, l'erreur ayant déjà été signalée). line est la ligne du premier jeton de
+	la construction, utilisée dans les messages d'erreur.
+*/
+class IRGenerator
+{
+public:
+	/** Les CFG sont alloués dans arena, les identificateurs internés dans interner : tous deux
+		appartiennent à la compilation et doivent vivre aussi longtemps que les CFG. La construction
+		de chaque fonction est ajoutée à tracer, s'il est donné */
+	IRGenerator(Arena *arena, Interner *interner, Tracer *tracer = nullptr);
+
+	// Programme : toutes les fonctions sont déclarées avant la construction de la première
+	void begin_program(ostream &log);							/**< les erreurs du programme sont écrites dans log */
+	bool declare_function(const string &name, int nbParams); /**< false, après l'avoir signalé, si name est déjà défini */
+	list<CFG *> *end_program();								 /**< nullptr si une fonction a été définie deux fois */
+
+	void begin_function(const string &name, const vector<string> &params, size_t line);
+	void end_function();
+
+	// Instructions
+	void declare(const string &name, size_t line);		/**< int name; */
+	int define(const string &name, size_t line);		/**< partie gauche de int name = ... */
+	int assign_target(const string &name, size_t line); /**< partie gauche de name = ... */
+	int assign(int var, int value);
+	int ret(int var);
+
+	// Expressions : rendent le symbole qui contient le résultat
+	int constant(const string &text);
+	int variable(const string &name, size_t line);
+	int binary(const string &op, int left, int right, size_t line); /**< op : + - * / == != < > */
+	int unary(char op, int operand, size_t line);					 /**< op : - ou ! */
+	int begin_call(const string &name, int nbArgs, size_t line);	 /**< résultat de l'appel, avant l'évaluation des arguments */
+	void end_call(int result, const string &name, const vector<int> &args);
+
+	// Blocs et structures de contrôle
+	int begin_block(); /**< rend la portée à restaurer par end_block */
+	void end_block(int initialScope);
+
+	/** Blocs d'un if, créés par begin_if après l'évaluation de la condition */
+	struct IfBlocks
+	{
+		BasicBlock *then;
+		BasicBlock *elsebb;
+		BasicBlock *endif;
+	};
+	/** Avec un else, c'est lui qui est construit en premier : begin_if y place le bloc courant */
+	IfBlocks begin_if(int comp, bool hasElse);
+	void end_else(IfBlocks &blocks);
+	void begin_then(IfBlocks &blocks);
+	void end_if(IfBlocks &blocks);
+
+	/** Blocs d'un while, créés avant l'évaluation de la condition */
+	struct WhileBlocks
+	{
+		BasicBlock *whilebb;
+		BasicBlock *bodybb;
+		BasicBlock *endwhile;
+	};
+	WhileBlocks begin_while();
+	void begin_while_body(WhileBlocks &blocks, int comp);
+	void end_while(WhileBlocks &blocks);
+
+private:
+	bool check_initialized(int var, size_t line); /**< signale une lecture de var avant son initialisation */
+
+	Arena *arena;
+	Interner *interner;
+	list<CFG *> *cfgs;
+	map<string, int> functionTable;
+	ostream *log;
+	bool redefinition;
+	CFG *currentCFG;
+	int countBlock;
+	int countReturn;
+	BasicBlock *currentEpilogue;
+	SymbolTable symbols;
+	Tracer *tracer;
+	double functionStart; /**< date du début de la fonction courante dans la trace */
+};
+
+#endif
@@ -0,0 +1,235 @@
+#include "Scanner.h"
+
+#include <cstring>
+
+namespace
+{
+	/** Règle du lexer à appliquer selon le premier caractère d'un jeton */
+	enum CharClass : unsigned char
+	{
+		invalid,
+		space,	 /**< espace, tabulation, retour chariot */
+		newline,
+		digit,
+		letter,	 /**< lettre ou _ */
+		single,	 /**< jeton d'un seul caractère, donné par CharTable::kinds */
+		equals,	 /**< = ou == */
+		bang,	 /**< ! ou != */
+		slash,	 /**< / ou début de commentaire */
+		directive	 /**< directive du préprocesseur, ignorée jusqu'à la fin de la ligne */
+	};
+
+	struct CharTable
+	{
+		CharClass classes[256];
+		TokenKind kinds[256];
+
+		constexpr CharTable() : classes(), kinds()
+		{
+			for (int c = 0; c < 256; c++)
+			{
+				classes[c] = invalid;
+				kinds[c] = TokenKind::end;
+			}
+			classes[(unsigned char)' '] = space;
+			classes[(unsigned char)'\t'] = space;
+			classes[(unsigned char)'\r'] = space;
+			classes[(unsigned char)'\n'] = newline;
+			for (int c = '0'; c <= '9'; c++)
+			{
+				classes[c] = digit;
+			}
+			for (int c = 'a'; c <= 'z'; c++)
+			{
+				classes[c] = letter;
+				classes[c - 'a' + 'A'] = letter;
+			}
+			classes[(unsigned char)'_'] = letter;
+			classes[(unsigned char)'='] = equals;
+			classes[(unsigned char)'!'] = bang;
+			classes[(unsigned char)'/'] = slash;
+			classes[(unsigned char)'#'] = directive;
+
+			const char singles[] = "(){},;+-*<>";
+			const TokenKind singleKinds[] = {TokenKind::lparen, TokenKind::rparen, TokenKind::lbrace, TokenKind::rbrace, TokenKind::comma, TokenKind::semicolon,
+											 TokenKind::plus, TokenKind::minus, TokenKind::star, TokenKind::less, TokenKind::greater};
+			for (int i = 0; singles[i] != '\0'; i++)
+			{
+				classes[(unsigned char)singles[i]] = single;
+				kinds[(unsigned char)singles[i]] = singleKinds[i];
+			}
+		}
+	};
+
+	constexpr CharTable table;
+
+	bool is_name_char(char c)
+	{
+		CharClass cls = table.classes[(unsigned char)c];
+		return cls == letter || cls == digit;
+	}
+
+	/** Mot-clé écrit par les length caractères de text, name sinon */
+	TokenKind keyword(const char *text, int length)
+	{
+		switch (length)
+		{
+			case 2:
+				return memcmp(text, "if", 2) == 0 ? TokenKind::kw_if : TokenKind::name;
+			case 3:
+				return memcmp(text, "int", 3) == 0 ? TokenKind::kw_int : TokenKind::name;
+			case 4:
+				return memcmp(text, "else", 4) == 0 ? TokenKind::kw_else : TokenKind::name;
+			case 5:
+				return memcmp(text, "while", 5) == 0 ? TokenKind::kw_while : TokenKind::name;
+			case 6:
+				return memcmp(text, "return", 6) == 0 ? TokenKind::kw_return : TokenKind::name;
+			default:
+				return TokenKind::name;
+		}
+	}
+}
+
+Scanner::Scanner(const char *data, size_t size) : data(data), size(size), line(1), lineStart(0)
+{
+}
+
+void Scanner::push(TokenKind kind, int start, int length)
+{
+	tokens.push_back({kind, start, length, line, start - lineStart, -1});
+}
+
+void Scanner::run(ostream &log)
+{
+	// Un jeton pour 4 caractères environ : évite la plupart des réallocations
+	tokens.reserve(size / 4 + 1);
+	int p = 0;
+	while (p < size)
+	{
+		int start = p;
+		switch (table.classes[(unsigned char)data[p]])
+		{
+			case space:
+				p++;
+				break;
+			case newline:
+				p++;
+				line++;
+				lineStart = p;
+				break;
+			case digit:
+				while (p < size && table.classes[(unsigned char)data[p]] == digit)
+				{
+					p++;
+				}
+				push(TokenKind::constant, start, p - start);
+				break;
+			case letter:
+				while (p < size && is_name_char(data[p]))
+				{
+					p++;
+				}
+				push(keyword(data + start, p - start), start, p - start);
+				break;
+			case single:
+				push(table.kinds[(unsigned char)data[p]], start, 1);
+				p++;
+				break;
+			case equals:
+			case bang:
+			{
+				bool twoChars = p + 1 < size && data[p + 1] == '=';
+				if (data[p] == '=')
+				{
+					push(twoChars ? TokenKind::equal : TokenKind::assign, start, twoChars ? 2 : 1);
+				}
+				else
+				{
+					push(twoChars ? TokenKind::notequal : TokenKind::bang, start, twoChars ? 2 : 1);
+				}
+				p += twoChars ? 2 : 1;
+				break;
+			}
+			case slash:
+			{
+				// Un commentaire non terminé n'est pas un commentaire : / reste une division
+				const char *close = nullptr;
+				if (p + 1 < size && data[p + 1] == '*')
+				{
+					for (int q = p + 2; q + 1 < size; q++)
+					{
+						if (data[q] == '*' && data[q + 1] == '/')
+						{
+							close = data + q;
+							break;
+						}
+					}
+				}
+				if (close == nullptr)
+				{
+					push(TokenKind::slash, start, 1);
+					p++;
+					break;
+				}
+				int end = close - data + 2;
+				for (; p < end; p++)
+				{
+					if (data[p] == '\n')
+					{
+						line++;
+						lineStart = p + 1;
+					}
+				}
+				break;
+			}
+			case directive:
+			{
+				const char *eol = (const char *)memchr(data + p, '\n', size - p);
+				if (eol != nullptr)
+				{
+					p = eol - data + 1;
+					line++;
+					lineStart = p;
+					break;
+				}
+				// Sans fin de ligne, la directive n'est pas reconnue : même traitement qu'un caractère invalide
+				[[fallthrough]];
+			}
+			default:
+				log << "line " << line << ":" << start - lineStart << " token recognition error at: '" << data[p] << "'" << endl;
+				p++;
+				break;
+		}
+	}
+	push(TokenKind::end, size, 0);
+	pair_brackets();
+}
+
+void Scanner::pair_brackets()
+{
+	vector<int> open;
+	for (int i = 0; i < tokens.size(); i++)
+	{
+		TokenKind kind = tokens[i].kind;
+		if (kind == TokenKind::lparen || kind == TokenKind::lbrace)
+		{
+			open.push_back(i);
+		}
+		else if (kind == TokenKind::rparen || kind == TokenKind::rbrace)
+		{
+			// Une parenthèse fermée par une accolade (ou l'inverse) reste sans partenaire : le parser signalera l'erreur
+			TokenKind expected = kind == TokenKind::rparen ? TokenKind::lparen : TokenKind::lbrace;
+			if (!open.empty() && tokens[open.back()].kind == expected)
+			{
+				tokens[open.back()].partner = i;
+				tokens[i].partner = open.back();
+				open.pop_back();
+			}
+		}
+	}
+}
+
+string Scanner::text(const ScanToken &token) const
+{
+	return string(data + token.start, token.length);
+}
@@ -0,0 +1,80 @@
+#ifndef SCANNER_H
+#define SCANNER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/** Jetons de la grammaire ifcc.g4 */
+enum class TokenKind : unsigned char
+{
+	end,
+	constant,
+	name,
+	kw_int,
+	kw_return,
+	kw_if,
+	kw_else,
+	kw_while,
+	lparen,
+	rparen,
+	lbrace,
+	rbrace,
+	comma,
+	semicolon,
+	assign,
+	bang,
+	plus,
+	minus,
+	star,
+	slash,
+	less,
+	greater,
+	equal,
+	notequal
+};
+
+struct ScanToken
+{
+	TokenKind kind;
+	int start;	 /**< position du premier caractère dans le texte */
+	int length;
+	int line;	 /**< à partir de 1 */
+	int column;	 /**< à partir de 0, comme les messages d'ANTLR */
+	int partner; /**< pour une parenthèse ou une accolade : indice du jeton qui lui correspond, -1 s'il manque */
+};
+
+/** Analyse lexicale écrite à la main, équivalente au lexer généré depuis ifcc.g4.
+
+	Le caractère courant est classé par une table de 256 entrées, qui donne directement la règle à
+	appliquer : les mots-clés sont reconnus après coup parmi les identificateurs. Tout le texte est
+	découpé d'un coup dans un tableau de jetons, que DescentParser parcourt par indice : les
+	parenthèses et accolades y sont appariées, ce qui permet de sauter un bloc sans l'analyser.
+
+	Comme le lexer d'ANTLR, un caractère qui ne commence aucun jeton est signalé puis ignoré.
+*/
+class Scanner
+{
+public:
+	Scanner(const char *data, size_t size);
+
+	/** Découpe tout le texte ; le dernier jeton est end. Les caractères non reconnus sont signalés sur log */
+	void run(ostream &log);
+
+	string text(const ScanToken &token) const;
+
+	vector<ScanToken> tokens;
+
+private:
+	void push(TokenKind kind, int start, int length);
+	void pair_brackets();
+
+	const char *data;
+	int size;
+	int line;
+	int lineStart; /**< position du début de la ligne courante */
+};
+
+#endif
@@ -0,0 +1,183 @@
+#include "SourceInput.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SourceFile::SourceFile() : bytes(nullptr), length(0), mapped(false)
+{
+}
+
+SourceFile::~SourceFile()
+{
+	if (mapped)
+	{
+		munmap((void *)bytes, length);
+	}
+}
+
+bool SourceFile::open(const string &path)
+{
+	if (path == "-")
+	{
+		return read_stream(STDIN_FILENO);
+	}
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+	struct stat info;
+	bool ok;
+	if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+	{
+		void *mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapping != MAP_FAILED)
+		{
+			// Le lexer lit le texte une seule fois, du début à la fin
+			madvise(mapping, info.st_size, MADV_SEQUENTIAL);
+			bytes = (const char *)mapping;
+			length = info.st_size;
+			mapped = true;
+			ok = true;
+		}
+		else
+		{
+			ok = read_stream(fd);
+		}
+	}
+	else
+	{
+		// Tube, fichier spécial ou fichier vide : rien à projeter
+		ok = read_stream(fd);
+	}
+	close(fd);
+	return ok;
+}
+
+bool SourceFile::read_stream(int fd)
+{
+	size_t block = 1 << 16;
+	buffer.clear();
+	while (true)
+	{
+		size_t used = buffer.size();
+		buffer.resize(used + block);
+		ssize_t n = read(fd, buffer.data() + used, block);
+		if (n < 0 && errno == EINTR)
+		{
+			buffer.resize(used);
+			continue;
+		}
+		if (n <= 0)
+		{
+			buffer.resize(used);
+			if (n < 0)
+			{
+				return false;
+			}
+			break;
+		}
+		buffer.resize(used + n);
+	}
+	bytes = buffer.data();
+	length = buffer.size();
+	mapped = false;
+	return true;
+}
+
+const char *SourceFile::data()
+{
+	return bytes;
+}
+
+size_t SourceFile::size()
+{
+	return length;
+}
+
+bool SourceFile::is_mapped()
+{
+	return mapped;
+}
+
+SourceStream::SourceStream(const char *data, size_t size, const string &name)
+	: bytes((const unsigned char *)data), length(size), position(0), name(name)
+{
+}
+
+void SourceStream::consume()
+{
+	if (position >= length)
+	{
+		throw antlr4::IllegalStateException("cannot consume EOF");
+	}
+	position++;
+}
+
+size_t SourceStream::LA(ssize_t i)
+{
+	// Même convention qu'ANTLRInputStream : LA(1) est le caractère courant, LA(-1) le précédent
+	if (i == 0)
+	{
+		return 0;
+	}
+	ssize_t p = (ssize_t)position + (i < 0 ? i : i - 1);
+	if (p < 0 || p >= (ssize_t)length)
+	{
+		return antlr4::IntStream::EOF;
+	}
+	return bytes[p];
+}
+
+ssize_t SourceStream::mark()
+{
+	// Tout le texte reste accessible : les marques n'ont rien à retenir
+	return -1;
+}
+
+void SourceStream::release(ssize_t marker)
+{
+}
+
+size_t SourceStream::index()
+{
+	return position;
+}
+
+void SourceStream::seek(size_t index)
+{
+	position = index < length ? index : length;
+}
+
+size_t SourceStream::size()
+{
+	return length;
+}
+
+string SourceStream::getSourceName() const
+{
+	return name.empty() ? antlr4::IntStream::UNKNOWN_SOURCE_NAME : name;
+}
+
+string SourceStream::getText(const antlr4::misc::Interval &interval)
+{
+	if (interval.a < 0 || interval.b < 0 || (size_t)interval.a >= length)
+	{
+		return "";
+	}
+	size_t start = interval.a;
+	size_t stop = (size_t)interval.b < length ? interval.b : length - 1;
+	if (stop < start)
+	{
+		return "";
+	}
+	return string((const char *)bytes + start, stop - start + 1);
+}
+
+string SourceStream::toString() const
+{
+	return string((const char *)bytes, length);
+}
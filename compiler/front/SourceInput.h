@@ -0,0 +1,70 @@
+#ifndef SOURCE_INPUT_H
+#define SOURCE_INPUT_H
+
+#include <string>
+#include <vector>
+
+#include "antlr4-runtime.h"
+
+using namespace std;
+
+/** Texte source de la compilation.
+
+	Un fichier ordinaire est projeté en mémoire (mmap) : ses octets ne sont pas recopiés. Les
+	tubes et l'entrée standard (nom "-") ne peuvent pas l'être : ils sont lus par blocs dans un
+	tampon. Dans les deux cas le texte reste valide jusqu'à la destruction de l'objet.
+*/
+class SourceFile
+{
+public:
+	SourceFile();
+	~SourceFile();
+	SourceFile(const SourceFile &) = delete;
+	SourceFile &operator=(const SourceFile &) = delete;
+
+	bool open(const string &path); /**< faux si le fichier ne peut pas être lu */
+
+	const char *data();
+	size_t size();
+	bool is_mapped(); /**< vrai si le texte est projeté, faux s'il a été lu dans le tampon */
+
+private:
+	bool read_stream(int fd);
+
+	const char *bytes;
+	size_t length;
+	bool mapped;
+	vector<char> buffer; /**< texte lu d'un tube ou de l'entrée standard */
+};
+
+/** Flux de caractères du lexer lu directement dans le texte source.
+
+	ANTLRInputStream recopie le texte en le décodant en UTF-32 : ce flux lit au contraire les
+	octets en place, un octet par caractère. La grammaire n'accepte que de l'ASCII hors des
+	commentaires et des directives, ignorés par le lexer : les jetons sont donc les mêmes, et
+	leur texte est rendu tel qu'il est dans le fichier.
+*/
+class SourceStream : public antlr4::CharStream
+{
+public:
+	SourceStream(const char *data, size_t size, const string &name);
+
+	void consume() override;
+	size_t LA(ssize_t i) override;
+	ssize_t mark() override;
+	void release(ssize_t marker) override;
+	size_t index() override;
+	void seek(size_t index) override;
+	size_t size() override;
+	string getSourceName() const override;
+	string getText(const antlr4::misc::Interval &interval) override;
+	string toString() const override;
+
+private:
+	const unsigned char *bytes;
+	size_t length;
+	size_t position;
+	string name;
+};
+
+#endif
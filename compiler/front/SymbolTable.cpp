@@ -0,0 +1,56 @@
+#include "SymbolTable.h"
+
+SymbolTable::SymbolTable(Interner *interner) : cfg(nullptr), interner(interner)
+{
+}
+
+void SymbolTable::begin_function(CFG *cfg)
+{
+	this->cfg = cfg;
+	while (!scopes.empty())
+	{
+		close_scope();
+	}
+}
+
+void SymbolTable::open_scope()
+{
+	scopes.push_back(vector<int>());
+}
+
+void SymbolTable::close_scope()
+{
+	for (int id : scopes.back())
+	{
+		bindings[id].pop_back();
+	}
+	scopes.pop_back();
+}
+
+int SymbolTable::declare(const string &name, string type, bool initialized)
+{
+	int id = interner->intern(name);
+	if (id >= bindings.size())
+	{
+		bindings.resize(id + 1);
+	}
+	int depth = scopes.size();
+	if (!bindings[id].empty() && bindings[id].back().depth == depth)
+	{
+		return -1;
+	}
+	int symbol = cfg->add_to_symbol_table(name, type, initialized, false);
+	bindings[id].push_back({symbol, depth});
+	scopes.back().push_back(id);
+	return symbol;
+}
+
+int SymbolTable::resolve(const string &name)
+{
+	int id = interner->find(name);
+	if (id == -1 || id >= bindings.size() || bindings[id].empty())
+	{
+		return -1;
+	}
+	return bindings[id].back().symbol;
+}
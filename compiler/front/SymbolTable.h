@@ -0,0 +1,50 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <string>
+#include <vector>
+
+#include "../back/IR.h"
+#include "../back/Interner.h"
+
+using namespace std;
+
+/** Table des symboles à portées, tenue par IRGenerator pendant la construction de l'IR : elle sert
+	aux deux front-ends, la visite de l'arbre ANTLR (buildIR) comme l'analyse descendante sans arbre
+	(DescentParser).
+
+	Chaque identificateur est interné une fois pour toute la compilation (Interner), et son numéro
+	sert d'indice dans la table. Pour chaque identificateur, la table garde la pile des symboles
+	qui le déclarent dans les portées ouvertes : le symbole visible est le sommet de la pile, la
+	résolution d'un nom ne parcourt donc pas les portées englobantes. Fermer une portée retire ses
+	déclarations des piles.
+
+	Les symboles eux-mêmes sont rangés à plat dans le CFG de la fonction, indexés par leur numéro :
+	une fois le nom résolu ici, l'IR et le back-end ne manipulent plus que ce numéro.
+*/
+class SymbolTable
+{
+public:
+	SymbolTable(Interner *interner);
+
+	void begin_function(CFG *cfg); /**< les symboles déclarés ensuite sont créés dans cfg */
+	void open_scope();
+	void close_scope();
+
+	int declare(const string &name, string type, bool initialized); /**< crée le symbole dans la portée courante ; -1 si le nom y est déjà déclaré */
+	int resolve(const string &name); /**< symbole visible sous ce nom, -1 s'il n'est pas déclaré */
+
+private:
+	struct Binding
+	{
+		int symbol;
+		int depth; /**< profondeur de la portée qui déclare le symbole */
+	};
+
+	CFG *cfg;
+	Interner *interner;
+	vector<vector<Binding>> bindings; /**< par identificateur : symboles visibles, du plus externe au plus interne */
+	vector<vector<int>> scopes;		  /**< par portée ouverte : identificateurs qu'elle déclare */
+};
+
+#endif
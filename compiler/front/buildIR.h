@@ -4,12 +4,21 @@
 #include "../generated/ifccBaseVisitor.h"
 
 #include "../back/IR.h"
+#include "IRGenerator.h"
 #include <list>
 #include <string>
 
+/** Front-end ANTLR : parcourt l'arbre construit par ifccParser et confie chaque construction à
+	IRGenerator, partagé avec DescentParser */
 class buildIR : public ifccBaseVisitor
 {
 public:
+	/** Les CFG sont alloués dans arena, les identificateurs internés dans interner : tous deux
+		appartiennent à la compilation et doivent vivre aussi longtemps que les CFG. Les erreurs du
+		programme (fonction définie deux fois) sont écrites dans log : visit() rend alors nullptr.
+		tracer, s'il est donné, reçoit la construction de chaque fonction */
+	buildIR(Arena *arena, Interner *interner, ostream &log, Tracer *tracer = nullptr);
+
 	virtual antlrcpp::Any visitProg(ifccParser::ProgContext *ctx) override;
 	virtual antlrcpp::Any visitFunction(ifccParser::FunctionContext *ctx) override;
 	virtual antlrcpp::Any visitStatement(ifccParser::StatementContext *ctx) override;
@@ -32,8 +41,6 @@ public:
 	virtual antlrcpp::Any visitBlockif(ifccParser::BlockifContext *ctx) override;
 	virtual antlrcpp::Any visitBlockwhile(ifccParser::BlockwhileContext *ctx) override;
 private:
-	list<CFG*>* cfgs;
-	map<string, int> functionTable;
-	CFG* currentCFG;
-	int countBlock;
+	IRGenerator generator;
+	ostream &log;
 };
@@ -1,54 +1,521 @@
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <cstdlib>
 #include <any>
+#include <chrono>
+#include <sstream>
+#include <memory>
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "antlr4-runtime.h"
 #include "generated/ifccLexer.h"
 #include "generated/ifccParser.h"
 #include "generated/ifccBaseVisitor.h"
 #include "./front/buildIR.h"
+#include "./front/DescentParser.h"
+#include "./front/SourceInput.h"
+#include "./opt/Optimizer.h"
+#include "./opt/Inliner.h"
+#include "./back/WorkerPool.h"
+#include "./back/Tracer.h"
 
 using namespace antlr4;
 using namespace std;
 
-int main(int argn, const char **argv)
+/** Optimise et émet une fonction : son code est ajouté à out, ses statistiques écrites dans log.
+    Seul le CFG de la fonction est modifié : plusieurs fonctions peuvent être compilées en même temps (-j).
+    Rend le temps passé dans l'émission. */
+static chrono::steady_clock::duration compile_function(CFG *cfg, bool optimize, bool rotateLoops, bool stats, AsmWriter &out, ostream &log, Tracer *tracer)
+{
+  TraceSpan function(tracer, "fonction", &cfg->label, false);
+  if (optimize)
+  {
+    TraceSpan optimization(tracer, "optimisation", &cfg->label, false);
+    Optimizer optimizer(cfg, rotateLoops);
+    optimizer.run();
+    if (stats)
+    {
+      optimizer.print_stats(log);
+    }
+  }
+  TraceSpan emission(tracer, "émission", &cfg->label, false);
+  auto emitStart = chrono::steady_clock::now();
+  cfg->gen_asmX86(out);
+  auto emitTime = chrono::steady_clock::now() - emitStart;
+  emission.end();
+  if (stats)
+  {
+    log << cfg->label << ": frame de " << cfg->get_frame_size() << " octets" << (cfg->has_frame_pointer() ? "" : " (feuille, sans %rbp)") << ", coût estimé " << cfg->get_estimated_cost() << endl;
+    for (auto &rule : cfg->get_peephole_stats())
+    {
+      log << cfg->label << ": " << rule.second << " " << rule.first << " (peephole)" << endl;
+    }
+  }
+  return emitTime;
+}
+
+static bool write_output(AsmWriter &out, int fd, ostream &log)
+{
+  if (!out.flush(fd))
+  {
+    log << "error: cannot write the assembly output" << endl;
+    return false;
+  }
+  return true;
+}
+
+/** Écrit les erreurs du lexer et du parser générés dans le journal du fichier compilé, au format de
+    ConsoleErrorListener : avec plusieurs fichiers et -j, elles restent avec les autres messages du
+    fichier au lieu d'être mêlées sur cerr à celles des autres threads. */
+class LogErrorListener : public BaseErrorListener
 {
-  stringstream in;
-  if (argn==2)
+public:
+  LogErrorListener(ostream &log) : log(log) {}
+
+  void syntaxError(Recognizer *recognizer, Token *offendingSymbol, size_t line, size_t charPositionInLine, const string &msg, exception_ptr e) override
   {
-     ifstream lecture(argv[1]);
-     in << lecture.rdbuf();
+    log << "line " << line << ":" << charPositionInLine << " " << msg << endl;
+  }
+
+private:
+  ostream &log;
+};
+
+/** Analyse en deux temps : la prédiction SLL, sans contexte d'appel, suffit à presque tous les
+    programmes et évite les retours arrière coûteux du mode LL. Au premier échec, l'analyse SLL est
+    abandonnée (BailErrorStrategy, sans message) et le programme est réanalysé en LL complet, qui
+    signale les vraies erreurs de syntaxe à listener : le résultat est toujours celui d'une analyse LL. */
+static tree::ParseTree *parse_two_stage(ifccParser &parser, ANTLRErrorListener *listener, bool &fellBack)
+{
+  parser.getInterpreter<atn::ParserATNSimulator>()->setPredictionMode(atn::PredictionMode::SLL);
+  parser.removeErrorListeners();
+  parser.setErrorHandler(make_shared<BailErrorStrategy>());
+  try
+  {
+    fellBack = false;
+    return parser.axiom();
+  }
+  catch (ParseCancellationException &)
+  {
+    fellBack = true;
+  }
+  // reset() remet le flux de jetons au début ; les DFA construits en SLL restent valables en LL
+  parser.reset();
+  parser.addErrorListener(listener);
+  parser.setErrorHandler(make_shared<DefaultErrorStrategy>());
+  parser.getInterpreter<atn::ParserATNSimulator>()->setPredictionMode(atn::PredictionMode::LL);
+  return parser.axiom();
+}
+
+/** Statistiques de prédiction par décision de la grammaire (--parser-profile), de la plus coûteuse
+    à la moins coûteuse : nombre de prédictions, temps, profondeur de lookahead en SLL et en LL,
+    replis sur LL complet, ambiguïtés et erreurs. Le profil est pris en mode LL : chaque prédiction
+    y est d'abord tentée sans contexte et n'est reprise avec contexte qu'en cas de conflit. Une décision qui regarde loin ou qui se replie
+    souvent sur LL désigne une règle à factoriser. */
+static void print_parser_profile(ifccParser &parser, ostream &log)
+{
+  auto *profiler = dynamic_cast<atn::ProfilingATNSimulator *>(parser.getInterpreter<atn::ParserATNSimulator>());
+  if (profiler == nullptr)
+  {
+    return;
+  }
+  // DecisionInfo a un membre constant : on trie des pointeurs
+  vector<atn::DecisionInfo> infos = profiler->getDecisionInfo();
+  vector<const atn::DecisionInfo *> decisions;
+  for (auto &info : infos)
+  {
+    decisions.push_back(&info);
+  }
+  sort(decisions.begin(), decisions.end(), [](const atn::DecisionInfo *a, const atn::DecisionInfo *b) {
+    return a->timeInPrediction > b->timeInPrediction;
+  });
+  const atn::ATN &grammar = parser.getATN();
+  log << "profil des décisions, analyse en mode LL" << endl;
+  log << "décision  règle          appels   temps µs  SLL moy/max  LL moy/max  replis LL  ambiguïtés  erreurs" << endl;
+  for (auto info : decisions)
+  {
+    if (info->invocations == 0)
+    {
+      continue;
+    }
+    const string &rule = parser.getRuleNames()[grammar.decisionToState[info->decision]->ruleIndex];
+    char line[160];
+    snprintf(line, sizeof(line), "%8zu  %-12s %8lld %10.1f %7.2f/%-4lld %6.2f/%-4lld %9lld %11zu %8zu",
+             info->decision, rule.c_str(), info->invocations, info->timeInPrediction / 1000.0,
+             (double)info->SLL_TotalLook / info->invocations, info->SLL_MaxLook,
+             info->LL_Fallback == 0 ? 0.0 : (double)info->LL_TotalLook / info->LL_Fallback, info->LL_MaxLook,
+             info->LL_Fallback, info->ambiguities.size(), info->errors.size());
+    log << line << endl;
+  }
+}
+
+/** Options de la ligne de commande, communes à tous les fichiers compilés */
+struct Options
+{
+  bool stats = false;
+  bool optimize = true;
+  bool rotateLoops = true;
+  int inlineThreshold = Inliner::defaultThreshold;
+  int jobs = 1;
+  string frontend = "antlr"; /**< "antlr" ou "rd" (lexer et parser écrits à la main) */
+  bool twoStage = true;      /**< analyse SLL d'abord, LL seulement en cas d'échec */
+  bool parserProfile = false;
+  string trace;              /**< fichier de la trace (--trace=out.json), vide sans trace */
+};
+
+/** Un fichier à compiler et l'assembleur qu'il produit ("-" : sortie standard) */
+struct Unit
+{
+  string input;
+  string output;
+};
+
+/** Compile un fichier. Les statistiques et les erreurs sont écrites dans log, et une erreur du
+    fichier rend false sans arrêter le processus ; functionPool, s'il est donné, répartit les
+    fonctions du fichier sur ses threads. Seule une erreur interne du compilateur (aucune
+    sélection d'instructions possible, InstructionSelector::cheapest) arrête encore tout le
+    processus par exit.
+
+    Le lexer et le parser générés gardent leur ATN et leurs DFA de prédiction dans des membres
+    statiques : tous les fichiers compilés par le même processus en profitent, seul le premier
+    paie leur construction.
+
+    tracer, s'il est donné, reçoit chaque phase de la compilation. */
+static bool compile_file(const Unit &unit, const Options &options, WorkerPool *functionPool, ostream &log, Tracer *tracer)
+{
+  TraceSpan compilation(tracer, "compilation", &unit.input);
+
+  // Le lexer lit directement le fichier projeté en mémoire, ou le tampon rempli depuis un tube
+  auto readStart = chrono::steady_clock::now();
+  TraceSpan reading(tracer, "lecture");
+  SourceFile source;
+  if (!source.open(unit.input))
+  {
+      log << "error: cannot read " << unit.input << endl;
+      return false;
+  }
+  reading.end();
+
+  // Les CFG et tout leur contenu sont alloués dans les arènes du fichier, rendues à la fin de sa compilation
+  Arena arena;
+  Interner interner;
+  list<CFG *>* cfgs;
+
+  // Temps de construction de l'IR et d'émission du code, affichés par --stats
+  chrono::steady_clock::duration buildTime;
+  if (options.frontend == "rd")
+  {
+      // Lexer et parser écrits à la main : l'IR est construit pendant l'analyse, sans arbre syntaxique
+      auto buildStart = chrono::steady_clock::now();
+      DescentParser parser(&arena, &interner, tracer);
+      cfgs = parser.parse(source.data(), source.size(), log);
+      buildTime = chrono::steady_clock::now() - buildStart;
+      if (cfgs == nullptr)
+      {
+          if (parser.has_syntax_error())
+          {
+              log << "error: syntax error during parsing" << endl;
+          }
+          return false;
+      }
+      if (options.stats)
+      {
+          log << "entrée : " << source.size() << " octets " << (source.is_mapped() ? "projetés" : "lus") << endl;
+          log << "front-end rd : analyse comprise dans la construction de l'IR" << endl;
+      }
   }
   else
   {
-      cerr << "usage: ifcc path/to/file.c" << endl ;
-      exit(1);
+      SourceStream input(source.data(), source.size(), unit.input);
+
+      ifccLexer lexer(&input);
+      LogErrorListener errorListener(log);
+      lexer.removeErrorListeners();
+      lexer.addErrorListener(&errorListener);
+      CommonTokenStream tokens(&lexer);
+
+      TraceSpan lexing(tracer, "lexer");
+      tokens.LT(1);
+      auto firstTokenTime = chrono::steady_clock::now() - readStart;
+      tokens.fill();
+      lexing.end();
+      if (options.stats)
+      {
+          log << "entrée : " << source.size() << " octets " << (source.is_mapped() ? "projetés" : "lus") << ", premier jeton après " << chrono::duration_cast<chrono::microseconds>(firstTokenTime).count() << " µs" << endl;
+      }
+
+      TraceSpan parsing(tracer, "analyse");
+      ifccParser parser(&tokens);
+      parser.removeErrorListeners();
+      parser.addErrorListener(&errorListener);
+      // Le profil est toujours pris en LL : une analyse SLL réussie ne tenterait jamais la prédiction
+      // avec contexte, et les colonnes LL du profil resteraient vides
+      bool twoStage = options.twoStage && !options.parserProfile;
+      if (options.parserProfile)
+      {
+          parser.setProfile(true);
+      }
+      bool fellBack = false;
+      tree::ParseTree* tree = twoStage ? parse_two_stage(parser, &errorListener, fellBack) : parser.axiom();
+      auto parseTime = chrono::steady_clock::now() - readStart;
+      parsing.end();
+      if (options.parserProfile)
+      {
+          print_parser_profile(parser, log);
+      }
+
+      if(parser.getNumberOfSyntaxErrors() != 0)
+      {
+          log << "error: syntax error during parsing" << endl;
+          return false;
+      }
+
+      TraceSpan building(tracer, "construction de l'IR");
+      auto buildStart = chrono::steady_clock::now();
+      buildIR IRBuilder(&arena, &interner, log, tracer);
+      cfgs = IRBuilder.visit(tree);
+      buildTime = chrono::steady_clock::now() - buildStart;
+      building.end();
+      if (cfgs == nullptr)
+      {
+          return false;
+      }
+      if (options.stats)
+      {
+          log << "front-end antlr (lexer et arbre syntaxique) : " << chrono::duration_cast<chrono::microseconds>(parseTime).count() << " µs, puis visite de l'arbre" << endl;
+          log << "analyse : " << (!twoStage ? "LL" : fellBack ? "SLL échouée, reprise en LL" : "SLL") << endl;
+      }
+  }
+  chrono::steady_clock::duration emitTime(0);
+
+  bool errors = false;
+  for(auto & cfg: *cfgs) {
+    errors = cfg->report_errors(log) || errors;
+  }
+  if (errors)
+  {
+    return false;
+  }
+
+  // L'intégration des appels recopie des fonctions dans d'autres : elle précède leurs optimisations
+  if (options.optimize)
+  {
+    TraceSpan inlining(tracer, "intégration des fonctions");
+    Inliner inliner(cfgs, options.inlineThreshold);
+    inliner.run();
+    if (options.stats)
+    {
+      inliner.print_stats(log);
+    }
+  }
+
+  // La sortie n'est créée qu'une fois le programme accepté
+  int fd = STDOUT_FILENO;
+  if (unit.output != "-")
+  {
+    fd = open(unit.output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+      log << "error: cannot write " << unit.output << endl;
+      return false;
+    }
   }
-  
-  ANTLRInputStream input(in.str());
 
-  ifccLexer lexer(&input);
-  CommonTokenStream tokens(&lexer);
+  TraceSpan backend(tracer, "optimisation et émission");
+  bool written = true;
+  if (functionPool == nullptr)
+  {
+    // Tampon réutilisé d'une fonction à l'autre, écrit en un seul appel système par fonction
+    AsmWriter writer;
+    for(auto & cfg: *cfgs) {
+      emitTime += compile_function(cfg, options.optimize, options.rotateLoops, options.stats, writer, log, tracer);
+      written = written && write_output(writer, fd, log);
+    }
+  }
+  else
+  {
+    // Chaque fonction a son tampon et ses statistiques, écrits ensuite dans l'ordre du source :
+    // la sortie est identique à celle de la compilation séquentielle
+    vector<CFG *> functions(cfgs->begin(), cfgs->end());
+    vector<AsmWriter> outputs(functions.size(), AsmWriter(0));
+    vector<ostringstream> logs(functions.size());
+    vector<chrono::steady_clock::duration> emitTimes(functions.size());
+    functionPool->run(functions.size(), [&](int i) {
+      emitTimes[i] = compile_function(functions[i], options.optimize, options.rotateLoops, options.stats, outputs[i], logs[i], tracer);
+    });
+    for (int i = 0; i < functions.size(); i++)
+    {
+      written = written && write_output(outputs[i], fd, log);
+      log << logs[i].str();
+      emitTime += emitTimes[i];
+    }
+  }
+  if (fd != STDOUT_FILENO)
+  {
+    close(fd);
+  }
+  backend.end();
 
-  tokens.fill();
+  if (options.stats)
+  {
+    log << "construction de l'IR : " << chrono::duration_cast<chrono::microseconds>(buildTime).count() << " µs, émission : " << chrono::duration_cast<chrono::microseconds>(emitTime).count() << " µs" << endl;
+    // Rien n'est rendu aux arènes avant la fin de la compilation : la taille finale est le pic
+    size_t used = arena.get_used();
+    size_t reserved = arena.get_reserved();
+    for (auto &cfg : *cfgs)
+    {
+      used += cfg->get_arena()->get_used();
+      reserved += cfg->get_arena()->get_reserved();
+    }
+    log << "arènes : pic de " << reserved << " octets réservés, " << used << " octets alloués, " << interner.size() << " chaînes internées" << endl;
+  }
 
-  ifccParser parser(&tokens);
-  tree::ParseTree* tree = parser.axiom();
+  return written;
+}
 
-  if(parser.getNumberOfSyntaxErrors() != 0)
+/** Écrit la trace de --trace, s'il y en a une */
+static bool write_trace(Tracer *tracer, const string &path)
+{
+  if (tracer != nullptr && !tracer->write(path))
   {
-      cerr << "error: syntax error during parsing" << endl;
+    cerr << "error: cannot write " << path << endl;
+    return false;
+  }
+  return true;
+}
+
+/** Nom de l'assembleur produit par défaut pour un fichier : file.c donne file.s */
+static string default_output(const string &input)
+{
+  if (input.size() > 2 && input.compare(input.size() - 2, 2, ".c") == 0)
+  {
+    return input.substr(0, input.size() - 2) + ".s";
+  }
+  return input + ".s";
+}
+
+int main(int argn, const char **argv)
+{
+  Options options;
+  vector<Unit> units;
+  bool usage = false;
+  for (int i = 1; i < argn; i++)
+  {
+      string arg = argv[i];
+      if (arg == "--stats")
+      {
+          options.stats = true;
+      }
+      else if (arg == "-O0")
+      {
+          options.optimize = false;
+      }
+      else if (arg == "--no-rotate")
+      {
+          options.rotateLoops = false;
+      }
+      else if (arg.compare(0, 19, "--inline-threshold=") == 0)
+      {
+          options.inlineThreshold = atoi(arg.c_str() + 19);
+      }
+      else if (arg == "--frontend=antlr" || arg == "--frontend=rd")
+      {
+          options.frontend = arg.substr(11);
+      }
+      else if (arg == "--no-sll")
+      {
+          options.twoStage = false;
+      }
+      else if (arg == "--parser-profile")
+      {
+          options.parserProfile = true;
+      }
+      else if (arg.compare(0, 8, "--trace=") == 0 && arg.size() > 8)
+      {
+          options.trace = arg.substr(8);
+      }
+      else if (arg == "-j" && i + 1 < argn)
+      {
+          options.jobs = atoi(argv[++i]);
+      }
+      else if (arg.compare(0, 2, "-j") == 0 && arg.size() > 2)
+      {
+          options.jobs = atoi(arg.c_str() + 2);
+      }
+      else if (arg == "-o" && i + 1 < argn && !units.empty() && units.back().output.empty())
+      {
+          // -o nomme la sortie du fichier qui le précède
+          units.back().output = argv[++i];
+      }
+      else if (arg[0] != '-' || arg == "-")
+      {
+          units.push_back({arg, ""});
+      }
+      else
+      {
+          usage = true;
+          break;
+      }
+  }
+  if (units.empty() || usage)
+  {
+      cerr << "usage: ifcc [--stats] [-O0] [--no-rotate] [--inline-threshold=N] [--frontend=antlr|rd] [--no-sll] [--parser-profile] [--trace=out.json] [-j N] file.c [-o file.s] [file2.c [-o file2.s] ...]" << endl ;
+      cerr << "       un seul fichier sans -o est compilé sur la sortie standard, - désigne l'entrée standard" << endl ;
       exit(1);
   }
+  // Un fichier seul garde la sortie standard ; plusieurs fichiers produisent chacun leur .s
+  for (auto &unit : units)
+  {
+      if (unit.output.empty())
+      {
+          unit.output = units.size() == 1 ? "-" : default_output(unit.input);
+      }
+  }
 
-  buildIR IRBuilder;
-  list<CFG *>* cfgs = IRBuilder.visit(tree);
+  // Sans --trace, aucun Tracer : les intervalles de trace ne coûtent qu'un test de pointeur
+  unique_ptr<Tracer> tracer;
+  if (!options.trace.empty())
+  {
+      tracer = make_unique<Tracer>();
+  }
 
-  for(auto & cfg: *cfgs) {
-    cfg->gen_asmX86(cout);
+  if (units.size() == 1)
+  {
+      // -j répartit les fonctions du fichier
+      WorkerPool pool(options.jobs);
+      int status = compile_file(units[0], options, options.jobs > 1 ? &pool : nullptr, cerr, tracer.get()) ? 0 : 1;
+      return write_trace(tracer.get(), options.trace) ? status : 1;
   }
 
-  return 0;
+  // Plusieurs fichiers : -j répartit les fichiers, et les messages de chacun sont affichés dans l'ordre
+  // de la ligne de commande. Un fichier erroné n'empêche pas la compilation des autres
+  vector<char> succeeded(units.size(), false);
+  vector<ostringstream> logs(units.size());
+  if (options.jobs <= 1)
+  {
+      for (int i = 0; i < units.size(); i++)
+      {
+          succeeded[i] = compile_file(units[i], options, nullptr, cerr, tracer.get());
+      }
+  }
+  else
+  {
+      WorkerPool pool(options.jobs);
+      pool.run(units.size(), [&](int i) {
+          succeeded[i] = compile_file(units[i], options, nullptr, logs[i], tracer.get());
+      });
+  }
+  int status = 0;
+  for (int i = 0; i < units.size(); i++)
+  {
+      cerr << logs[i].str();
+      if (!succeeded[i])
+      {
+          cerr << units[i].input << ": compilation échouée" << endl;
+          status = 1;
+      }
+  }
+  return write_trace(tracer.get(), options.trace) ? status : 1;
 }
@@ -0,0 +1,284 @@
+#include "CFGSimplifier.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+CFGSimplifier::CFGSimplifier(CFG *cfg) : cfg(cfg), entry(nullptr), removedBlocks(0), removedInstrs(0)
+{
+	for (auto &bb : cfg->get_bbs())
+	{
+		if (bb->label == cfg->label)
+		{
+			entry = bb;
+		}
+	}
+}
+
+int CFGSimplifier::get_removed_blocks()
+{
+	return removedBlocks;
+}
+
+int CFGSimplifier::get_removed_instrs()
+{
+	return removedInstrs;
+}
+
+void CFGSimplifier::run()
+{
+	if (entry == nullptr)
+	{
+		return;
+	}
+	bool changed = true;
+	while (changed)
+	{
+		changed = remove_unreachable_blocks();
+		changed = thread_jumps() || changed;
+		changed = merge_blocks() || changed;
+		changed = remove_dead_code() > 0 || changed;
+	}
+}
+
+void CFGSimplifier::remove_block(BasicBlock *bb)
+{
+	vector<BasicBlock *> &bbs = cfg->get_bbs();
+	// Le bloc et ses instructions restent dans l'arène du CFG jusqu'à sa destruction
+	bbs.erase(find(bbs.begin(), bbs.end(), bb));
+	removedBlocks++;
+}
+
+unordered_map<BasicBlock *, int> CFGSimplifier::count_preds()
+{
+	// Le prologue n'est pas compté : il mène toujours au bloc d'entrée, qui n'est jamais supprimé
+	unordered_map<BasicBlock *, int> nbPreds;
+	for (auto &bb : cfg->get_bbs())
+	{
+		if (bb->label == "prologue" || bb->label == "epilogue")
+		{
+			continue;
+		}
+		if (bb->exit_true != nullptr)
+		{
+			nbPreds[bb->exit_true]++;
+		}
+		if (bb->exit_false != nullptr && bb->exit_false != bb->exit_true)
+		{
+			nbPreds[bb->exit_false]++;
+		}
+	}
+	return nbPreds;
+}
+
+bool CFGSimplifier::remove_unreachable_blocks()
+{
+	unordered_set<BasicBlock *> reached = {entry};
+	vector<BasicBlock *> stack = {entry};
+	while (!stack.empty())
+	{
+		BasicBlock *bb = stack.back();
+		stack.pop_back();
+		for (BasicBlock *succ : {bb->exit_true, bb->exit_false})
+		{
+			if (succ != nullptr && succ->label != "epilogue" && !reached.count(succ))
+			{
+				reached.insert(succ);
+				stack.push_back(succ);
+			}
+		}
+	}
+
+	vector<BasicBlock *> unreachable;
+	for (auto &bb : cfg->get_bbs())
+	{
+		if (bb->label != "prologue" && bb->label != "epilogue" && !reached.count(bb))
+		{
+			unreachable.push_back(bb);
+		}
+	}
+	for (auto &bb : unreachable)
+	{
+		removedInstrs += bb->instrs.size();
+		remove_block(bb);
+	}
+	return !unreachable.empty();
+}
+
+bool CFGSimplifier::thread_jumps()
+{
+	bool changed = false;
+	for (auto &bb : cfg->get_bbs())
+	{
+		if (bb->label == "prologue" || bb->label == "epilogue")
+		{
+			continue;
+		}
+		for (BasicBlock **exit : {&bb->exit_true, &bb->exit_false})
+		{
+			// On suit la chaîne de blocs vides ; une boucle de blocs vides (while vide) est laissée telle quelle
+			BasicBlock *target = *exit;
+			unordered_set<BasicBlock *> seen;
+			while (target != nullptr && target != entry && target->label != "epilogue" && target->instrs.empty()
+				   && target->exit_false == nullptr && !seen.count(target))
+			{
+				seen.insert(target);
+				target = target->exit_true;
+			}
+			if (target == nullptr || target == *exit || seen.count(target))
+			{
+				continue;
+			}
+			// Un saut conditionnel ne peut pas viser l'épilogue, qui est recopié en fin de bloc
+			if (target->label == "epilogue" && bb->exit_false != nullptr)
+			{
+				continue;
+			}
+			*exit = target;
+			changed = true;
+		}
+
+		// Les deux branches mènent au même bloc : le test ne sert plus
+		if (bb->exit_false != nullptr && bb->exit_false == bb->exit_true)
+		{
+			if (!bb->instrs.empty() && bb->instrs.back()->op == IRInstr::if_comp)
+			{
+				bb->instrs.pop_back();
+				removedInstrs++;
+			}
+			bb->exit_false = nullptr;
+			changed = true;
+		}
+	}
+	return changed;
+}
+
+bool CFGSimplifier::merge_blocks()
+{
+	bool changed = false;
+	unordered_map<BasicBlock *, int> nbPreds = count_preds();
+	vector<BasicBlock *> &bbs = cfg->get_bbs();
+	for (int i = 0; i < bbs.size(); i++)
+	{
+		BasicBlock *bb = bbs[i];
+		if (bb->label == "prologue" || bb->label == "epilogue")
+		{
+			continue;
+		}
+		// Tant que le bloc saute sans condition vers un bloc dont il est le seul prédécesseur, il l'absorbe
+		while (bb->exit_false == nullptr && bb->exit_true != nullptr)
+		{
+			BasicBlock *next = bb->exit_true;
+			if (next == bb || next == entry || next->label == "epilogue" || nbPreds[next] != 1)
+			{
+				break;
+			}
+			for (auto &instr : next->instrs)
+			{
+				instr->bb = bb;
+				bb->instrs.push_back(instr);
+			}
+			next->instrs.clear();
+			bb->exit_true = next->exit_true;
+			bb->exit_false = next->exit_false;
+			int index = find(bbs.begin(), bbs.end(), next) - bbs.begin();
+			remove_block(next);
+			if (index < i)
+			{
+				i--;
+			}
+			changed = true;
+		}
+	}
+	return changed;
+}
+
+int CFGSimplifier::remove_dead_code()
+{
+	// Marquage depuis les instructions utiles par elles-mêmes (return, test, appel, paramètres) :
+	// une variable lue par une instruction utile rend utiles toutes ses définitions
+	int nbVars = cfg->get_nb_symbols();
+	vector<vector<IRInstr *>> definitions(nbVars);
+	vector<bool> live(nbVars, false);
+	vector<int> worklist;
+	unordered_set<IRInstr *> useful;
+
+	auto mark = [&](IRInstr *instr) {
+		useful.insert(instr);
+		for (int var : instr->get_uses())
+		{
+			if (var != -1 && !live[var])
+			{
+				live[var] = true;
+				worklist.push_back(var);
+			}
+		}
+	};
+
+	for (auto &bb : cfg->get_bbs())
+	{
+		for (auto &instr : bb->instrs)
+		{
+			switch (instr->op)
+			{
+				case IRInstr::ldconst:
+				case IRInstr::copy:
+				case IRInstr::add:
+				case IRInstr::sub:
+				case IRInstr::mul:
+				case IRInstr::div:
+				case IRInstr::cmp_eq:
+				case IRInstr::cmp_ne:
+				case IRInstr::cmp_lt:
+				case IRInstr::cmp_le:
+				case IRInstr::copy_not:
+				case IRInstr::copy_neg:
+				case IRInstr::phi:
+				{
+					int def = instr->get_def();
+					if (def != -1)
+					{
+						definitions[def].push_back(instr);
+						break;
+					}
+					mark(instr);
+					break;
+				}
+				default:
+					mark(instr);
+					break;
+			}
+		}
+	}
+	while (!worklist.empty())
+	{
+		int var = worklist.back();
+		worklist.pop_back();
+		for (auto &instr : definitions[var])
+		{
+			if (!useful.count(instr))
+			{
+				mark(instr);
+			}
+		}
+	}
+
+	int removed = 0;
+	for (auto &bb : cfg->get_bbs())
+	{
+		vector<IRInstr *> kept;
+		for (auto &instr : bb->instrs)
+		{
+			if (useful.count(instr))
+			{
+				kept.push_back(instr);
+			}
+			else
+			{
+				removed++;
+			}
+		}
+		bb->instrs = kept;
+	}
+	removedInstrs += removed;
+	return removed;
+}
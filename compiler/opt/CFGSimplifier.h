@@ -0,0 +1,46 @@
+#ifndef CFG_SIMPLIFIER_H
+#define CFG_SIMPLIFIER_H
+
+#include <vector>
+#include <unordered_map>
+
+#include "../back/IR.h"
+
+using namespace std;
+
+/** Nettoyage du CFG d'une fonction : moins de blocs, moins de sauts, moins d'instructions.
+
+	run() supprime les blocs jamais atteints (par exemple le code après un return), fait sauter
+	directement les prédécesseurs d'un bloc vide vers son successeur, fusionne un bloc avec son
+	unique successeur quand il en est l'unique prédécesseur, et supprime les instructions dont le
+	résultat n'est jamais lu. Le CFG ne doit pas contenir de phi.
+
+	remove_dead_code() ne fait que la dernière étape, qui reste valable en forme SSA.
+*/
+class CFGSimplifier
+{
+public:
+	CFGSimplifier(CFG *cfg);
+
+	void run();
+	int remove_dead_code();
+
+	/** Nombre de blocs supprimés ou fusionnés */
+	int get_removed_blocks();
+	/** Nombre d'instructions supprimées */
+	int get_removed_instrs();
+
+private:
+	bool remove_unreachable_blocks();
+	bool thread_jumps();
+	bool merge_blocks();
+	void remove_block(BasicBlock *bb);
+	unordered_map<BasicBlock *, int> count_preds();
+
+	CFG *cfg;
+	BasicBlock *entry;
+	int removedBlocks;
+	int removedInstrs;
+};
+
+#endif
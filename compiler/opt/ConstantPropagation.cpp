@@ -0,0 +1,370 @@
+#include "ConstantPropagation.h"
+
+#include <climits>
+
+ConstantPropagation::ConstantPropagation(CFG *cfg) : cfg(cfg)
+{
+	unordered_map<BasicBlock *, int> blockIndex;
+	for (auto &bb : cfg->get_bbs())
+	{
+		if (bb->label != "prologue" && bb->label != "epilogue")
+		{
+			blockIndex[bb] = blocks.size();
+			blocks.push_back(bb);
+		}
+	}
+	preds.assign(blocks.size(), vector<int>());
+	trueTarget.assign(blocks.size(), -1);
+	falseTarget.assign(blocks.size(), -1);
+	for (int b = 0; b < blocks.size(); b++)
+	{
+		if (blockIndex.count(blocks[b]->exit_true))
+		{
+			trueTarget[b] = blockIndex[blocks[b]->exit_true];
+			preds[trueTarget[b]].push_back(b);
+		}
+		if (blockIndex.count(blocks[b]->exit_false))
+		{
+			falseTarget[b] = blockIndex[blocks[b]->exit_false];
+			preds[falseTarget[b]].push_back(b);
+		}
+	}
+
+	// Un temporaire défini une seule fois a une valeur globale, les autres symboles sont suivis par bloc
+	int nbVars = cfg->get_nb_symbols();
+	vector<int> nbDefs(nbVars, 0);
+	for (auto &bb : blocks)
+	{
+		for (auto &instr : bb->instrs)
+		{
+			for (int var : instr->get_defs())
+			{
+				if (var != -1)
+				{
+					nbDefs[var]++;
+				}
+			}
+		}
+	}
+	nbLocals = 0;
+	localIndex.assign(nbVars, -1);
+	for (int var = 0; var < nbVars; var++)
+	{
+		if (!cfg->get_symbol(var)->isTemporary() || nbDefs[var] > 1)
+		{
+			localIndex[var] = nbLocals++;
+		}
+	}
+	globals.assign(nbVars, {Value::UNDEF, 0});
+}
+
+ConstantPropagation::Value ConstantPropagation::meet(Value a, Value b)
+{
+	if (a.state == Value::UNDEF)
+	{
+		return b;
+	}
+	if (b.state == Value::UNDEF)
+	{
+		return a;
+	}
+	if (a.state == Value::CONST && b.state == Value::CONST && a.constant == b.constant)
+	{
+		return a;
+	}
+	return {Value::VARYING, 0};
+}
+
+ConstantPropagation::Value ConstantPropagation::get_value(int var, vector<Value> &locals)
+{
+	if (var == -1)
+	{
+		return {Value::VARYING, 0};
+	}
+	if (localIndex[var] != -1)
+	{
+		return locals[localIndex[var]];
+	}
+	return globals[var];
+}
+
+void ConstantPropagation::set_value(int var, Value value, vector<Value> &locals)
+{
+	if (var == -1)
+	{
+		return;
+	}
+	if (localIndex[var] != -1)
+	{
+		locals[localIndex[var]] = value;
+	}
+	else
+	{
+		// La valeur d'un temporaire ne fait que descendre dans le treillis, ce qui garantit la terminaison
+		Value merged = meet(globals[var], value);
+		if (!(merged == globals[var]))
+		{
+			globals[var] = merged;
+			changed = true;
+		}
+	}
+}
+
+bool ConstantPropagation::fold(IRInstr::Operation op, int a, int b, int &result)
+{
+	// Calcul sur 64 bits puis troncature : même comportement que les instructions 32 bits générées
+	long long x = a, y = b;
+	switch (op)
+	{
+		case IRInstr::add:
+			result = (int)(unsigned int)(x + y);
+			return true;
+		case IRInstr::sub:
+			result = (int)(unsigned int)(x - y);
+			return true;
+		case IRInstr::mul:
+			result = (int)(unsigned int)(x * y);
+			return true;
+		case IRInstr::div:
+			// La division par zéro et INT_MIN / -1 sont laissées à l'exécution
+			if (b == 0 || (a == INT_MIN && b == -1))
+			{
+				return false;
+			}
+			result = a / b;
+			return true;
+		case IRInstr::cmp_eq:
+			result = a == b;
+			return true;
+		case IRInstr::cmp_ne:
+			result = a != b;
+			return true;
+		case IRInstr::cmp_lt:
+			result = a < b;
+			return true;
+		case IRInstr::cmp_le:
+			result = a <= b;
+			return true;
+		default:
+			return false;
+	}
+}
+
+ConstantPropagation::Value ConstantPropagation::transfer(IRInstr *instr, vector<Value> &locals)
+{
+	Value result = {Value::VARYING, 0};
+	switch (instr->op)
+	{
+		case IRInstr::ldconst:
+			result = {Value::CONST, instr->params[1].value};
+			break;
+		case IRInstr::copy:
+			result = get_value(instr->get_uses()[0], locals);
+			break;
+		case IRInstr::add:
+		case IRInstr::sub:
+		case IRInstr::mul:
+		case IRInstr::div:
+		case IRInstr::cmp_eq:
+		case IRInstr::cmp_ne:
+		case IRInstr::cmp_lt:
+		case IRInstr::cmp_le:
+		{
+			vector<int> uses = instr->get_uses();
+			Value a = get_value(uses[0], locals);
+			Value b = get_value(uses[1], locals);
+			int folded;
+			if (a.state == Value::CONST && b.state == Value::CONST)
+			{
+				if (fold(instr->op, a.constant, b.constant, folded))
+				{
+					result = {Value::CONST, folded};
+				}
+			}
+			else if (instr->op == IRInstr::mul && ((a.state == Value::CONST && a.constant == 0) || (b.state == Value::CONST && b.constant == 0)))
+			{
+				result = {Value::CONST, 0};
+			}
+			else if (a.state == Value::UNDEF || b.state == Value::UNDEF)
+			{
+				result = {Value::UNDEF, 0};
+			}
+			break;
+		}
+		case IRInstr::copy_not:
+		case IRInstr::copy_neg:
+		{
+			Value a = get_value(instr->get_uses()[0], locals);
+			if (a.state == Value::CONST)
+			{
+				result = {Value::CONST, instr->op == IRInstr::copy_not ? a.constant == 0 : (int)(0u - (unsigned int)a.constant)};
+			}
+			else
+			{
+				result = a;
+			}
+			break;
+		}
+		default:
+			break;
+	}
+	for (int var : instr->get_defs())
+	{
+		set_value(var, result, locals);
+	}
+	return result;
+}
+
+void ConstantPropagation::visit_block(int b)
+{
+	BasicBlock *bb = blocks[b];
+	vector<Value> state(nbLocals, {Value::UNDEF, 0});
+	if (bb->label == cfg->label)
+	{
+		// À l'entrée de la fonction, une variable non initialisée peut valoir n'importe quoi
+		state.assign(nbLocals, {Value::VARYING, 0});
+	}
+	for (int p : preds[b])
+	{
+		bool fromTrue = trueEdge[p] && trueTarget[p] == b;
+		bool fromFalse = falseEdge[p] && falseTarget[p] == b;
+		if (fromTrue || fromFalse)
+		{
+			for (int i = 0; i < nbLocals; i++)
+			{
+				state[i] = meet(state[i], out[p][i]);
+			}
+		}
+	}
+	in[b] = state;
+
+	for (auto &instr : bb->instrs)
+	{
+		transfer(instr, state);
+	}
+	if (state != out[b])
+	{
+		out[b] = state;
+		changed = true;
+	}
+
+	// Seuls les arcs que la condition peut emprunter deviennent exécutables
+	bool takeTrue = true, takeFalse = false;
+	if (bb->exit_false != nullptr && !bb->instrs.empty() && bb->instrs.back()->op == IRInstr::if_comp)
+	{
+		Value condition = get_value(bb->instrs.back()->get_uses()[0], state);
+		takeTrue = condition.state == Value::VARYING || (condition.state == Value::CONST && condition.constant != 0);
+		takeFalse = condition.state == Value::VARYING || (condition.state == Value::CONST && condition.constant == 0);
+	}
+	for (int s : {takeTrue ? trueTarget[b] : -1, takeFalse ? falseTarget[b] : -1})
+	{
+		if (s != -1 && !executable[s])
+		{
+			executable[s] = true;
+			changed = true;
+		}
+	}
+	if ((takeTrue && !trueEdge[b]) || (takeFalse && !falseEdge[b]))
+	{
+		trueEdge[b] = trueEdge[b] || takeTrue;
+		falseEdge[b] = falseEdge[b] || takeFalse;
+		changed = true;
+	}
+}
+
+bool ConstantPropagation::run()
+{
+	int nbBlocks = blocks.size();
+	in.assign(nbBlocks, vector<Value>(nbLocals, {Value::UNDEF, 0}));
+	out.assign(nbBlocks, vector<Value>(nbLocals, {Value::UNDEF, 0}));
+	executable.assign(nbBlocks, false);
+	trueEdge.assign(nbBlocks, false);
+	falseEdge.assign(nbBlocks, false);
+	for (int b = 0; b < nbBlocks; b++)
+	{
+		if (blocks[b]->label == cfg->label)
+		{
+			executable[b] = true;
+		}
+	}
+
+	changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (int b = 0; b < nbBlocks; b++)
+		{
+			if (executable[b])
+			{
+				visit_block(b);
+			}
+		}
+	}
+
+	// Une condition encore indéfinie au point fixe ne devrait pas exister : dans le doute on ne touche à rien
+	for (int b = 0; b < nbBlocks; b++)
+	{
+		if (executable[b] && blocks[b]->exit_false != nullptr && !trueEdge[b] && !falseEdge[b])
+		{
+			return false;
+		}
+	}
+	bool modified = false;
+	for (int b = 0; b < nbBlocks; b++)
+	{
+		modified = modified || !executable[b] || (blocks[b]->exit_false != nullptr && trueEdge[b] != falseEdge[b]);
+	}
+	rewrite();
+	return modified;
+}
+
+void ConstantPropagation::rewrite()
+{
+	for (int b = 0; b < blocks.size(); b++)
+	{
+		if (!executable[b])
+		{
+			continue;
+		}
+		BasicBlock *bb = blocks[b];
+		vector<Value> state = in[b];
+		for (auto &instr : bb->instrs)
+		{
+			Value value = transfer(instr, state);
+			bool foldable = instr->op == IRInstr::copy || instr->op == IRInstr::add || instr->op == IRInstr::sub || instr->op == IRInstr::mul || instr->op == IRInstr::div || instr->op == IRInstr::cmp_eq || instr->op == IRInstr::cmp_ne || instr->op == IRInstr::cmp_lt || instr->op == IRInstr::cmp_le || instr->op == IRInstr::copy_not || instr->op == IRInstr::copy_neg;
+			if (foldable && value.state == Value::CONST)
+			{
+				IRInstr *folded = cfg->create_instr(bb, IRInstr::ldconst, *instr->type, {instr->params[0], IROperand::constant(value.constant)}, instr->scope);
+				instr = folded;
+			}
+		}
+
+		// Condition constante : le if_comp disparaît au profit d'un saut inconditionnel
+		if (bb->exit_false != nullptr && trueEdge[b] != falseEdge[b])
+		{
+			bb->instrs.pop_back();
+			if (falseEdge[b])
+			{
+				bb->exit_true = bb->exit_false;
+			}
+			bb->exit_false = nullptr;
+		}
+	}
+
+	// Les blocs jamais atteints sont retirés du CFG
+	vector<BasicBlock *> &bbs = cfg->get_bbs();
+	vector<BasicBlock *> reachable;
+	int b = 0;
+	for (auto &bb : bbs)
+	{
+		if (bb->label == "prologue" || bb->label == "epilogue")
+		{
+			reachable.push_back(bb);
+		}
+		else if (executable[b++])
+		{
+			reachable.push_back(bb);
+		}
+	}
+	bbs = reachable;
+}
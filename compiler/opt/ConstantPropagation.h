@@ -0,0 +1,69 @@
+#ifndef CONSTANT_PROPAGATION_H
+#define CONSTANT_PROPAGATION_H
+
+#include <vector>
+#include <unordered_map>
+
+#include "../back/IR.h"
+
+using namespace std;
+
+/** Propagation de constantes conditionnelle (SCCP) sur un CFG.
+
+	Chaque variable prend une valeur du treillis INDEFINI > CONSTANTE > VARIABLE.
+	Les temporaires n'ayant qu'une seule définition, leur valeur est globale au CFG ;
+	celle des variables du programme est suivie bloc par bloc.
+	Seuls les arcs dont la condition peut être vraie (resp. fausse) sont parcourus,
+	si bien que les blocs then/else d'une condition constante ne sont jamais visités.
+
+	Une fois le point fixe atteint, les calculs constants deviennent des ldconst,
+	les if_comp constants des sauts inconditionnels et les blocs inaccessibles sont supprimés.
+*/
+class ConstantPropagation
+{
+public:
+	ConstantPropagation(CFG *cfg);
+
+	/** Renvoie vrai si le CFG a été modifié */
+	bool run();
+
+private:
+	struct Value
+	{
+		enum State
+		{
+			UNDEF,
+			CONST,
+			VARYING
+		} state;
+		int constant;
+		bool operator==(const Value &other) const
+		{
+			return state == other.state && (state != CONST || constant == other.constant);
+		}
+	};
+
+	Value meet(Value a, Value b);
+	Value get_value(int var, vector<Value> &locals);
+	void set_value(int var, Value value, vector<Value> &locals);
+	/** Évalue l'instruction, met à jour les valeurs et renvoie la valeur de son résultat */
+	Value transfer(IRInstr *instr, vector<Value> &locals);
+	bool fold(IRInstr::Operation op, int a, int b, int &result);
+	void visit_block(int block);
+	void rewrite();
+
+	CFG *cfg;
+	vector<BasicBlock *> blocks;
+	vector<vector<int>> preds;
+	vector<int> trueTarget, falseTarget; /**< indices de exit_true / exit_false dans blocks, -1 hors CFG */
+	vector<int> localIndex; /**< numéro de symbole -> indice dans l'état par bloc, -1 pour un temporaire */
+	int nbLocals;
+	vector<Value> globals;	  /**< valeur des temporaires, indexée par numéro de symbole */
+	vector<vector<Value>> in; /**< état des variables du programme à l'entrée de chaque bloc */
+	vector<vector<Value>> out;
+	vector<bool> executable;
+	vector<bool> trueEdge, falseEdge; /**< arcs exit_true / exit_false exécutables */
+	bool changed;
+};
+
+#endif
@@ -0,0 +1,159 @@
+#include "DominatorTree.h"
+
+#include <algorithm>
+
+DominatorTree::DominatorTree(CFG *cfg) : cfg(cfg)
+{
+	number_blocks();
+	compute_idoms();
+	compute_frontiers();
+}
+
+void DominatorTree::number_blocks()
+{
+	BasicBlock *entry = nullptr;
+	for (auto &bb : cfg->get_bbs())
+	{
+		if (bb->label == cfg->label)
+		{
+			entry = bb;
+		}
+	}
+	if (entry == nullptr)
+	{
+		return;
+	}
+
+	// Parcours en profondeur itératif : les blocs sont rangés en ordre postfixe puis retournés
+	vector<BasicBlock *> postorder;
+	unordered_map<BasicBlock *, bool> visited;
+	vector<pair<BasicBlock *, int>> stack = {{entry, 0}};
+	visited[entry] = true;
+	while (!stack.empty())
+	{
+		BasicBlock *bb = stack.back().first;
+		int next = stack.back().second++;
+		BasicBlock *succ = next == 0 ? bb->exit_true : next == 1 ? bb->exit_false : nullptr;
+		if (next >= 2)
+		{
+			postorder.push_back(bb);
+			stack.pop_back();
+		}
+		else if (succ != nullptr && succ->label != "epilogue" && !visited[succ])
+		{
+			visited[succ] = true;
+			stack.push_back({succ, 0});
+		}
+	}
+	blocks.assign(postorder.rbegin(), postorder.rend());
+	for (int b = 0; b < blocks.size(); b++)
+	{
+		blockIndex[blocks[b]] = b;
+	}
+
+	preds.assign(blocks.size(), vector<int>());
+	succs.assign(blocks.size(), vector<int>());
+	for (int b = 0; b < blocks.size(); b++)
+	{
+		for (BasicBlock *succ : {blocks[b]->exit_true, blocks[b]->exit_false})
+		{
+			if (succ != nullptr && blockIndex.count(succ))
+			{
+				succs[b].push_back(blockIndex[succ]);
+				preds[blockIndex[succ]].push_back(b);
+			}
+		}
+	}
+}
+
+int DominatorTree::intersect(int a, int b)
+{
+	// En ordre postfixe inverse, un dominateur a toujours un numéro plus petit
+	while (a != b)
+	{
+		while (a > b)
+		{
+			a = idom[a];
+		}
+		while (b > a)
+		{
+			b = idom[b];
+		}
+	}
+	return a;
+}
+
+void DominatorTree::compute_idoms()
+{
+	int nbBlocks = blocks.size();
+	idom.assign(nbBlocks, -1);
+	if (nbBlocks == 0)
+	{
+		return;
+	}
+	idom[0] = 0;
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (int b = 1; b < nbBlocks; b++)
+		{
+			int newIdom = -1;
+			for (int p : preds[b])
+			{
+				if (idom[p] != -1)
+				{
+					newIdom = newIdom == -1 ? p : intersect(p, newIdom);
+				}
+			}
+			if (newIdom != idom[b])
+			{
+				idom[b] = newIdom;
+				changed = true;
+			}
+		}
+	}
+	idom[0] = -1;
+
+	children.assign(nbBlocks, vector<int>());
+	depth.assign(nbBlocks, 0);
+	for (int b = 1; b < nbBlocks; b++)
+	{
+		children[idom[b]].push_back(b);
+		depth[b] = depth[idom[b]] + 1;
+	}
+}
+
+void DominatorTree::compute_frontiers()
+{
+	frontier.assign(blocks.size(), vector<int>());
+	for (int b = 0; b < blocks.size(); b++)
+	{
+		if (preds[b].size() < 2)
+		{
+			continue;
+		}
+		// Chaque prédécesseur remonte l'arbre jusqu'au dominateur immédiat de b
+		for (int p : preds[b])
+		{
+			int runner = p;
+			while (runner != idom[b])
+			{
+				if (find(frontier[runner].begin(), frontier[runner].end(), b) == frontier[runner].end())
+				{
+					frontier[runner].push_back(b);
+				}
+				runner = idom[runner];
+			}
+		}
+	}
+}
+
+bool DominatorTree::dominates(int a, int b)
+{
+	while (depth[b] > depth[a])
+	{
+		b = idom[b];
+	}
+	return a == b;
+}
@@ -0,0 +1,42 @@
+#ifndef DOMINATOR_TREE_H
+#define DOMINATOR_TREE_H
+
+#include <vector>
+#include <unordered_map>
+
+#include "../back/IR.h"
+
+using namespace std;
+
+/** Arbre des dominateurs et frontières de dominance d'un CFG.
+
+	Seuls les blocs atteignables depuis le bloc d'entrée (celui qui porte le nom de la fonction)
+	sont numérotés, dans l'ordre postfixe inverse ; le prologue et l'épilogue sont exclus.
+	Les dominateurs immédiats sont calculés par l'algorithme itératif de Cooper, Harvey et Kennedy.
+*/
+class DominatorTree
+{
+public:
+	DominatorTree(CFG *cfg);
+
+	/** Vrai si a domine b (a == b compris) */
+	bool dominates(int a, int b);
+
+	CFG *cfg;
+	vector<BasicBlock *> blocks; /**< blocs atteignables, en ordre postfixe inverse ; blocks[0] est l'entrée */
+	unordered_map<BasicBlock *, int> blockIndex;
+	vector<vector<int>> preds, succs;
+	vector<int> idom;				/**< dominateur immédiat, -1 pour l'entrée */
+	vector<vector<int>> children;	/**< fils dans l'arbre des dominateurs */
+	vector<vector<int>> frontier;	/**< frontière de dominance */
+
+private:
+	void number_blocks();
+	void compute_idoms();
+	void compute_frontiers();
+	int intersect(int a, int b);
+
+	vector<int> depth;
+};
+
+#endif
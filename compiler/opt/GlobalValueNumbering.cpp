@@ -0,0 +1,180 @@
+#include "GlobalValueNumbering.h"
+
+#include <algorithm>
+
+GlobalValueNumbering::GlobalValueNumbering(CFG *cfg) : cfg(cfg), eliminated(0)
+{
+	int nbVars = cfg->get_nb_symbols();
+	valueNumber.resize(nbVars);
+	for (int var = 0; var < nbVars; var++)
+	{
+		valueNumber[var] = var;
+	}
+	replacement.assign(nbVars, -1);
+
+	// Seuls les temporaires écrits une seule fois (les noms SSA) ont une valeur fixe
+	vector<int> nbDefs(nbVars, 0);
+	for (auto &bb : cfg->get_bbs())
+	{
+		for (auto &instr : bb->instrs)
+		{
+			for (int var : instr->get_defs())
+			{
+				if (var != -1)
+				{
+					nbDefs[var]++;
+				}
+			}
+		}
+	}
+	singleDef.assign(nbVars, false);
+	for (int var = 0; var < nbVars; var++)
+	{
+		singleDef[var] = nbDefs[var] == 1 && cfg->get_symbol(var)->isTemporary();
+	}
+}
+
+int GlobalValueNumbering::value_of(int var)
+{
+	return var == -1 ? -1 : valueNumber[var];
+}
+
+void GlobalValueNumbering::visit_block(BasicBlock *bb, vector<Key> &inserted)
+{
+	vector<IRInstr *> kept;
+	for (auto &instr : bb->instrs)
+	{
+		int def = instr->get_def();
+		if (def == -1 || !singleDef[def])
+		{
+			kept.push_back(instr);
+			continue;
+		}
+		vector<int> uses = instr->get_uses();
+		switch (instr->op)
+		{
+			case IRInstr::ldconst:
+			{
+				// Les numéros des constantes suivent ceux des symboles
+				int value = instr->params[1].value;
+				if (!constants.count(value))
+				{
+					int number = valueNumber.size() + constants.size();
+					constants[value] = number;
+				}
+				valueNumber[def] = constants[value];
+				break;
+			}
+			case IRInstr::copy:
+				valueNumber[def] = value_of(uses[0]);
+				break;
+			case IRInstr::phi:
+			{
+				int common = value_of(uses[0]);
+				for (int use : uses)
+				{
+					common = value_of(use) == common ? common : -1;
+				}
+				if (common != -1)
+				{
+					valueNumber[def] = common;
+				}
+				break;
+			}
+			case IRInstr::add:
+			case IRInstr::sub:
+			case IRInstr::mul:
+			case IRInstr::div:
+			case IRInstr::cmp_eq:
+			case IRInstr::cmp_ne:
+			case IRInstr::cmp_lt:
+			case IRInstr::cmp_le:
+			case IRInstr::copy_not:
+			case IRInstr::copy_neg:
+			{
+				int a = value_of(uses[0]);
+				int b = uses.size() > 1 ? value_of(uses[1]) : -1;
+				bool commutative = instr->op == IRInstr::add || instr->op == IRInstr::mul || instr->op == IRInstr::cmp_eq || instr->op == IRInstr::cmp_ne;
+				if (commutative && a > b)
+				{
+					swap(a, b);
+				}
+				Key key = make_tuple((int)instr->op, a, b);
+				auto found = available.find(key);
+				if (found != available.end())
+				{
+					// Valeur déjà calculée dans un bloc dominant : l'instruction disparaît
+					replacement[def] = found->second;
+					valueNumber[def] = valueNumber[found->second];
+					eliminated++;
+					continue;
+				}
+				available[key] = def;
+				inserted.push_back(key);
+				break;
+			}
+			default:
+				break;
+		}
+		kept.push_back(instr);
+	}
+	bb->instrs = kept;
+}
+
+void GlobalValueNumbering::replace_uses()
+{
+	for (auto &bb : cfg->get_bbs())
+	{
+		for (auto &instr : bb->instrs)
+		{
+			vector<int> uses = instr->get_uses();
+			for (int i = 0; i < uses.size(); i++)
+			{
+				if (uses[i] != -1 && replacement[uses[i]] != -1)
+				{
+					instr->set_use_operand(i, replacement[uses[i]]);
+				}
+			}
+		}
+	}
+}
+
+int GlobalValueNumbering::run()
+{
+	DominatorTree dom(cfg);
+	if (dom.blocks.empty())
+	{
+		return 0;
+	}
+
+	// Parcours en profondeur de l'arbre des dominateurs : une expression n'est disponible
+	// que dans le sous-arbre du bloc qui la calcule
+	vector<vector<Key>> inserted(dom.blocks.size());
+	vector<pair<int, int>> stack = {{0, 0}};
+	while (!stack.empty())
+	{
+		int b = stack.back().first;
+		int child = stack.back().second++;
+		if (child == 0)
+		{
+			visit_block(dom.blocks[b], inserted[b]);
+		}
+		if (child < dom.children[b].size())
+		{
+			stack.push_back({dom.children[b][child], 0});
+		}
+		else
+		{
+			for (auto &key : inserted[b])
+			{
+				available.erase(key);
+			}
+			stack.pop_back();
+		}
+	}
+	if (eliminated > 0)
+	{
+		replace_uses();
+	}
+	return eliminated;
+}
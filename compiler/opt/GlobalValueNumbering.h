@@ -0,0 +1,47 @@
+#ifndef GLOBAL_VALUE_NUMBERING_H
+#define GLOBAL_VALUE_NUMBERING_H
+
+#include <vector>
+#include <map>
+#include <tuple>
+
+#include "../back/IR.h"
+#include "DominatorTree.h"
+
+using namespace std;
+
+/** Numérotation globale des valeurs (GVN) sur la forme SSA, par parcours de l'arbre des dominateurs.
+
+	Deux calculs (add, sub, mul, div, cmp_*, copy_not, copy_neg) sur des opérandes de même numéro
+	donnent la même valeur : le second est supprimé et ses lectures utilisent le résultat du
+	premier, qui le domine. Les constantes sont numérotées par leur valeur, les copies et les phi
+	dont tous les arguments sont égaux reprennent le numéro de leur source.
+
+	Les appels sont traités de façon conservatrice : leur résultat n'est jamais égal à celui d'un
+	autre appel (putchar, getchar... ont des effets de bord).
+*/
+class GlobalValueNumbering
+{
+public:
+	GlobalValueNumbering(CFG *cfg);
+
+	/** Renvoie le nombre d'instructions supprimées */
+	int run();
+
+private:
+	typedef tuple<int, int, int> Key; /**< (opération, numéro de a, numéro de b) */
+
+	int value_of(int var);
+	void visit_block(BasicBlock *bb, vector<Key> &inserted);
+	void replace_uses();
+
+	CFG *cfg;
+	vector<int> valueNumber;	  /**< numéro de valeur de chaque symbole (lui-même par défaut) */
+	vector<int> replacement;	  /**< symbole qui remplace un résultat redondant, -1 sinon */
+	vector<bool> singleDef;
+	map<int, int> constants;	  /**< valeur d'une constante -> numéro */
+	map<Key, int> available;	  /**< expression -> symbole qui la contient, dans les blocs dominants */
+	int eliminated;
+};
+
+#endif
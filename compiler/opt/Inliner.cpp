@@ -0,0 +1,294 @@
+#include "Inliner.h"
+
+#include <algorithm>
+
+Inliner::Inliner(list<CFG *> *cfgs, int threshold) : cfgs(cfgs), threshold(threshold)
+{
+	for (auto &cfg : *cfgs)
+	{
+		functions[cfg->label] = cfg;
+	}
+	for (auto &cfg : *cfgs)
+	{
+		for (auto &bb : cfg->get_bbs())
+		{
+			for (auto &instr : bb->instrs)
+			{
+				CFG *callee = callee_of(instr);
+				if (callee != nullptr)
+				{
+					callees[cfg].insert(callee);
+					callSites[callee]++;
+				}
+			}
+		}
+	}
+}
+
+CFG *Inliner::callee_of(IRInstr *instr)
+{
+	// putchar, getchar... ne sont pas définies dans le programme : elles restent des appels
+	if (instr->op != IRInstr::call)
+	{
+		return nullptr;
+	}
+	auto found = functions.find(instr->params[1].get_label());
+	return found != functions.end() ? found->second : nullptr;
+}
+
+int Inliner::size(CFG *cfg)
+{
+	int total = 0;
+	for (auto &bb : cfg->get_bbs())
+	{
+		for (auto &instr : bb->instrs)
+		{
+			total += instr->op != IRInstr::function_params_initialisation;
+		}
+	}
+	return total;
+}
+
+int Inliner::nb_params(CFG *cfg)
+{
+	for (auto &bb : cfg->get_bbs())
+	{
+		if (bb->label == cfg->label && !bb->instrs.empty() && bb->instrs[0]->op == IRInstr::function_params_initialisation)
+		{
+			return bb->instrs[0]->params.size();
+		}
+	}
+	return 0;
+}
+
+bool Inliner::reaches(CFG *from, CFG *to)
+{
+	set<CFG *> seen = {from};
+	vector<CFG *> stack = {from};
+	while (!stack.empty())
+	{
+		CFG *cfg = stack.back();
+		stack.pop_back();
+		for (CFG *callee : callees[cfg])
+		{
+			if (callee == to)
+			{
+				return true;
+			}
+			if (!seen.count(callee))
+			{
+				seen.insert(callee);
+				stack.push_back(callee);
+			}
+		}
+	}
+	return false;
+}
+
+void Inliner::visit(CFG *cfg, set<CFG *> &visited, vector<CFG *> &postorder)
+{
+	visited.insert(cfg);
+	for (CFG *callee : callees[cfg])
+	{
+		if (!visited.count(callee))
+		{
+			visit(callee, visited, postorder);
+		}
+	}
+	postorder.push_back(cfg);
+}
+
+int Inliner::run()
+{
+	if (threshold <= 0)
+	{
+		return 0;
+	}
+	// Ordre postfixe du graphe d'appel : les appelés avant leurs appelants
+	set<CFG *> visited;
+	vector<CFG *> postorder;
+	for (auto &cfg : *cfgs)
+	{
+		if (!visited.count(cfg))
+		{
+			visit(cfg, visited, postorder);
+		}
+	}
+
+	int total = 0;
+	for (CFG *caller : postorder)
+	{
+		// Les appels recopiés depuis un appelé ont déjà été examinés dans celui-ci
+		vector<IRInstr *> calls;
+		for (auto &bb : caller->get_bbs())
+		{
+			for (auto &instr : bb->instrs)
+			{
+				if (callee_of(instr) != nullptr)
+				{
+					calls.push_back(instr);
+				}
+			}
+		}
+		int callerSize = size(caller);
+		for (auto &call : calls)
+		{
+			if (should_inline(caller, call, callerSize))
+			{
+				callerSize += size(callee_of(call));
+				inline_call(caller, call);
+				total++;
+			}
+		}
+	}
+	return total;
+}
+
+bool Inliner::should_inline(CFG *caller, IRInstr *call, int callerSize)
+{
+	CFG *callee = callee_of(call);
+	if (callee == caller || reaches(callee, caller) || call->params.size() - 2 != nb_params(callee))
+	{
+		return false;
+	}
+	int calleeSize = size(callee);
+	if (callerSize + calleeSize > maxCallerSize)
+	{
+		return false;
+	}
+	return calleeSize <= threshold || (callSites[callee] == 1 && calleeSize <= 4 * threshold);
+}
+
+void Inliner::inline_call(CFG *caller, IRInstr *call)
+{
+	CFG *callee = callee_of(call);
+	BasicBlock *bb = call->bb;
+	int scope = call->scope;
+	IROperand result = call->params[0];
+	vector<IROperand> args(call->params.begin() + 2, call->params.end());
+	string prefix = caller->label + "_inline" + to_string(++inlined[caller]) + "_";
+	vector<int> imported;
+	caller->import_symbols(callee, imported);
+
+	// Les instructions qui suivent l'appel passent dans un bloc de suite, où mènent les return
+	vector<IRInstr *> &instrs = bb->instrs;
+	int index = find(instrs.begin(), instrs.end(), call) - instrs.begin();
+	BasicBlock *next = caller->create_bb(prefix + "suite", bb->scope);
+	next->exit_true = bb->exit_true;
+	next->exit_false = bb->exit_false;
+	for (int i = index + 1; i < instrs.size(); i++)
+	{
+		instrs[i]->bb = next;
+		next->instrs.push_back(instrs[i]);
+	}
+	instrs.resize(index);
+
+	map<BasicBlock *, BasicBlock *> clones;
+	vector<BasicBlock *> layout;
+	BasicBlock *entry = nullptr;
+	vector<IROperand> params;
+	for (auto &calleeBB : callee->get_bbs())
+	{
+		if (calleeBB->label == "epilogue")
+		{
+			clones[calleeBB] = next;
+		}
+		else if (calleeBB->label != "prologue")
+		{
+			BasicBlock *clone = caller->create_bb(prefix + calleeBB->label, scope);
+			clones[calleeBB] = clone;
+			layout.push_back(clone);
+			if (calleeBB->label == callee->label)
+			{
+				entry = clone;
+			}
+		}
+	}
+
+	// Chaque variable nommée de l'appelé a sa copie dans les portées importées, chaque temporaire
+	// devient un nouveau temporaire de l'appelant
+	map<int, int> renamed;
+	auto rename = [&](IROperand &operand) {
+		if (!operand.is_var())
+		{
+			return;
+		}
+		int var = operand.value;
+		if (!callee->get_symbol(var)->isTemporary())
+		{
+			operand.value = imported[var];
+			return;
+		}
+		if (!renamed.count(var))
+		{
+			renamed[var] = caller->create_new_temp("inl");
+		}
+		operand.value = renamed[var];
+	};
+
+	for (auto &calleeBB : callee->get_bbs())
+	{
+		if (calleeBB->label == "prologue" || calleeBB->label == "epilogue")
+		{
+			continue;
+		}
+		BasicBlock *clone = clones[calleeBB];
+		clone->exit_true = calleeBB->exit_true != nullptr ? clones[calleeBB->exit_true] : nullptr;
+		clone->exit_false = calleeBB->exit_false != nullptr ? clones[calleeBB->exit_false] : nullptr;
+		for (auto &instr : calleeBB->instrs)
+		{
+			if (instr->op == IRInstr::function_params_initialisation)
+			{
+				params = instr->params;
+				for (auto &param : params)
+				{
+					rename(param);
+				}
+				continue;
+			}
+			IRInstr *copy;
+			if (instr->op == IRInstr::ret)
+			{
+				// return v : le résultat de l'appel reçoit v, puis le bloc saute vers la suite
+				copy = caller->create_instr(clone, IRInstr::copy, "int", {result, instr->params[0]}, scope);
+				rename(copy->params[1]);
+			}
+			else
+			{
+				copy = caller->create_instr(clone, instr->op, *instr->type, instr->params, scope);
+				for (auto &param : copy->params)
+				{
+					rename(param);
+				}
+			}
+			clone->instrs.push_back(copy);
+
+			CFG *called = callee_of(instr);
+			if (called != nullptr)
+			{
+				callSites[called]++;
+			}
+		}
+	}
+	callSites[callee]--;
+
+	// Passage des arguments : copies des valeurs de l'appelant vers les paramètres de l'appelé
+	for (int i = 0; i < params.size(); i++)
+	{
+		bb->add_IRInstr(IRInstr::copy, "int", {params[i], args[i]}, scope);
+	}
+	bb->exit_true = entry;
+	bb->exit_false = nullptr;
+
+	vector<BasicBlock *> &bbs = caller->get_bbs();
+	layout.push_back(next);
+	bbs.insert(find(bbs.begin(), bbs.end(), bb) + 1, layout.begin(), layout.end());
+}
+
+void Inliner::print_stats(ostream &o)
+{
+	for (auto &cfg : *cfgs)
+	{
+		o << cfg->label << ": " << inlined[cfg] << " appels intégrés (inlining)" << endl;
+	}
+}
@@ -0,0 +1,62 @@
+#ifndef INLINER_H
+#define INLINER_H
+
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "../back/IR.h"
+
+using namespace std;
+
+/** Intégration (inlining) des fonctions du programme à leurs sites d'appel.
+
+	Un call vers une fonction définie dans le programme est remplacé par une copie du CFG appelé :
+	le bloc de l'appel est coupé en deux, les paramètres reçoivent les arguments par des copies,
+	chaque return devient une copie vers le résultat de l'appel suivie d'un saut vers la suite.
+	Les variables de l'appelé sont recopiées dans l'appelant sous de nouveaux numéros
+	(CFG::import_symbols) et ses temporaires sont renommés en temporaires de l'appelant.
+
+	Modèle de coût : la taille d'une fonction est son nombre d'instructions IR. Un appel est
+	intégré si l'appelé fait au plus threshold instructions, ou s'il n'est appelé qu'à cet endroit
+	et fait au plus 4 * threshold instructions (la copie ne duplique alors presque rien). Les
+	fonctions récursives (directement ou non) ne sont jamais intégrées entre elles, et un appelant
+	ne grossit pas au-delà de maxCallerSize instructions.
+
+	Les fonctions sont traitées des feuilles du graphe d'appel vers main : un appelé est intégré
+	avec ses propres appels déjà remplacés. Il reste émis à part, il peut être appelé d'ailleurs.
+	À lancer avant les optimisations de chaque fonction, sur des CFG sans erreur.
+*/
+class Inliner
+{
+public:
+	Inliner(list<CFG *> *cfgs, int threshold);
+
+	/** Renvoie le nombre d'appels intégrés */
+	int run();
+
+	/** Affiche le nombre d'appels intégrés dans chaque fonction (option --stats) */
+	void print_stats(ostream &o);
+
+	static const int defaultThreshold = 30;
+	static const int maxCallerSize = 2000;
+
+private:
+	int size(CFG *cfg);
+	int nb_params(CFG *cfg);
+	CFG *callee_of(IRInstr *instr);
+	bool reaches(CFG *from, CFG *to);
+	void visit(CFG *cfg, set<CFG *> &visited, vector<CFG *> &postorder);
+	bool should_inline(CFG *caller, IRInstr *call, int callerSize);
+	void inline_call(CFG *caller, IRInstr *call);
+
+	list<CFG *> *cfgs;
+	int threshold;
+	map<string, CFG *> functions;
+	map<CFG *, set<CFG *>> callees; /**< graphe d'appel, figé avant l'intégration */
+	map<CFG *, int> callSites;		/**< nombre de call restant vers chaque fonction */
+	map<CFG *, int> inlined;		/**< appels intégrés dans chaque fonction */
+};
+
+#endif
@@ -0,0 +1,190 @@
+#include "LoopInvariantCodeMotion.h"
+
+#include <algorithm>
+
+LoopInvariantCodeMotion::LoopInvariantCodeMotion(CFG *cfg) : cfg(cfg), reaching(nullptr)
+{
+}
+
+int LoopInvariantCodeMotion::run()
+{
+	int hoisted = 0;
+	// Chaque déplacement modifie le CFG : les boucles et les analyses sont recalculées pour la suivante
+	unordered_set<BasicBlock *> done;
+	while (true)
+	{
+		NaturalLoops natural(cfg);
+		Loop *loop = nullptr;
+		for (auto &candidate : natural.loops)
+		{
+			if (!done.count(candidate.header) && candidate.header->label != cfg->label)
+			{
+				loop = &candidate;
+				break;
+			}
+		}
+		if (loop == nullptr)
+		{
+			break;
+		}
+		done.insert(loop->header);
+		BasicBlock *preheader = NaturalLoops::insert_preheader(cfg, *loop);
+
+		DominatorTree dom(cfg);
+		hoisted += hoist(*loop, preheader, dom);
+	}
+	return hoisted;
+}
+
+bool LoopInvariantCodeMotion::is_invariant(IRInstr *instr, int block, int index, Loop &loop)
+{
+	switch (instr->op)
+	{
+		case IRInstr::ldconst:
+		case IRInstr::copy:
+		case IRInstr::add:
+		case IRInstr::sub:
+		case IRInstr::mul:
+		case IRInstr::div:
+		case IRInstr::cmp_eq:
+		case IRInstr::cmp_ne:
+		case IRInstr::cmp_lt:
+		case IRInstr::cmp_le:
+		case IRInstr::copy_not:
+		case IRInstr::copy_neg:
+			break;
+		default:
+			return false;
+	}
+	if (instr->get_def() == -1)
+	{
+		return false;
+	}
+	for (int var : instr->get_uses())
+	{
+		if (var == -1)
+		{
+			return false;
+		}
+		vector<int> defs = reaching->reaching(block, index, var);
+		bool outside = true;
+		for (int d : defs)
+		{
+			outside = outside && !loop.contains.count(reaching->graph.blocks[reaching->defBlock[d]]);
+		}
+		if (!outside && (defs.size() != 1 || !invariants.count(reaching->definitions[defs[0]].first)))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool LoopInvariantCodeMotion::safe_division(IRInstr *instr, int block, int index)
+{
+	// Seul le diviseur compte : 0 est une erreur, -1 déborde pour INT_MIN
+	int divisor = instr->get_uses()[1];
+	vector<int> defs = reaching->reaching(block, index, divisor);
+	if (defs.size() != 1 || reaching->definitions[defs[0]].first->op != IRInstr::ldconst)
+	{
+		return false;
+	}
+	int value = reaching->definitions[defs[0]].first->params[1].value;
+	return value != 0 && value != -1;
+}
+
+int LoopInvariantCodeMotion::hoist(Loop &loop, BasicBlock *preheader, DominatorTree &dom)
+{
+	ReachingDefinitions rd(cfg);
+	rd.run();
+	reaching = &rd;
+	Liveness liveness(cfg);
+	liveness.run();
+	invariants.clear();
+
+	// Marquage jusqu'au point fixe : une opérande peut dépendre d'un calcul invariant plus loin dans la boucle
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (auto &bb : loop.blocks)
+		{
+			int block = rd.graph.blockIndex[bb];
+			for (int i = 0; i < bb->instrs.size(); i++)
+			{
+				if (!invariants.count(bb->instrs[i]) && is_invariant(bb->instrs[i], block, i, loop))
+				{
+					invariants.insert(bb->instrs[i]);
+					changed = true;
+				}
+			}
+		}
+	}
+
+	vector<int> defsInLoop(cfg->get_nb_symbols(), 0);
+	for (auto &bb : loop.blocks)
+	{
+		for (auto &instr : bb->instrs)
+		{
+			for (int var : instr->get_defs())
+			{
+				if (var != -1)
+				{
+					defsInLoop[var]++;
+				}
+			}
+		}
+	}
+	BitVector &liveAtHeader = liveness.liveIn[liveness.blockIndex[loop.header]];
+
+	// Déplacement dans l'ordre de la boucle : les opérandes invariantes sont déjà dans le pré-en-tête
+	unordered_set<IRInstr *> moved;
+	for (auto &bb : loop.blocks)
+	{
+		int block = rd.graph.blockIndex[bb];
+		bool dominatesExits = !loop.exits.empty();
+		for (auto &exit : loop.exits)
+		{
+			dominatesExits = dominatesExits && dom.dominates(dom.blockIndex[bb], dom.blockIndex[exit.first]);
+		}
+
+		vector<IRInstr *> kept;
+		for (int i = 0; i < bb->instrs.size(); i++)
+		{
+			IRInstr *instr = bb->instrs[i];
+			int def = instr->get_def();
+			bool movable = invariants.count(instr) && defsInLoop[def] == 1 && !liveAtHeader[def];
+			if (movable && !dominatesExits)
+			{
+				for (auto &exit : loop.exits)
+				{
+					auto target = liveness.blockIndex.find(exit.second);
+					movable = movable && (target == liveness.blockIndex.end() || !liveness.liveIn[target->second][def]);
+				}
+				movable = movable && (instr->op != IRInstr::div || safe_division(instr, block, i));
+			}
+			vector<int> uses = instr->get_uses();
+			for (int u = 0; movable && u < uses.size(); u++)
+			{
+				for (int d : rd.reaching(block, i, uses[u]))
+				{
+					IRInstr *source = rd.definitions[d].first;
+					movable = movable && (!loop.contains.count(rd.graph.blocks[rd.defBlock[d]]) || moved.count(source));
+				}
+			}
+			if (movable)
+			{
+				instr->bb = preheader;
+				preheader->instrs.push_back(instr);
+				moved.insert(instr);
+			}
+			else
+			{
+				kept.push_back(instr);
+			}
+		}
+		bb->instrs = kept;
+	}
+	reaching = nullptr;
+	return moved.size();
+}
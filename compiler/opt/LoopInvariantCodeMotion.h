@@ -0,0 +1,45 @@
+#ifndef LOOP_INVARIANT_CODE_MOTION_H
+#define LOOP_INVARIANT_CODE_MOTION_H
+
+#include <vector>
+#include <unordered_set>
+
+#include "../back/IR.h"
+#include "../back/Liveness.h"
+#include "NaturalLoops.h"
+#include "ReachingDefinitions.h"
+
+using namespace std;
+
+/** Sortie des calculs invariants des boucles (LICM), avant le passage en SSA.
+
+	Un calcul sans effet de bord (ldconst, copie, arithmétique, comparaison) est invariant quand
+	chacune de ses opérandes n'est atteinte que par des définitions extérieures à la boucle, ou
+	par une seule définition invariante. Il est déplacé dans le pré-en-tête de la boucle si
+	sa variable n'a pas d'autre définition dans la boucle, n'est pas vivante à l'entrée de
+	l'en-tête, et si son bloc domine toutes les sorties ou que la variable est morte à la sortie.
+
+	Le calcul est alors fait même quand la boucle ne l'aurait pas exécuté : une division n'est
+	déplacée que si son diviseur est une constante différente de 0 et de -1, ou si elle est de
+	toute façon exécutée avant de quitter la boucle. Les boucles internes sont traitées d'abord,
+	ce qui permet de sortir un calcul de plusieurs niveaux.
+*/
+class LoopInvariantCodeMotion
+{
+public:
+	LoopInvariantCodeMotion(CFG *cfg);
+
+	/** Renvoie le nombre d'instructions déplacées */
+	int run();
+
+private:
+	int hoist(Loop &loop, BasicBlock *preheader, DominatorTree &dom);
+	bool is_invariant(IRInstr *instr, int block, int index, Loop &loop);
+	bool safe_division(IRInstr *instr, int block, int index);
+
+	CFG *cfg;
+	ReachingDefinitions *reaching;
+	unordered_set<IRInstr *> invariants;
+};
+
+#endif
@@ -0,0 +1,142 @@
+#include "LoopRotation.h"
+
+#include <unordered_map>
+
+// Au-delà, recopier la condition coûte plus en taille de code que le saut économisé
+static const int maxConditionSize = 16;
+
+LoopRotation::LoopRotation(CFG *cfg) : cfg(cfg)
+{
+}
+
+int LoopRotation::run()
+{
+	int rotated = 0;
+	unordered_set<BasicBlock *> done;
+	while (true)
+	{
+		NaturalLoops natural(cfg);
+		Loop *loop = nullptr;
+		for (auto &candidate : natural.loops)
+		{
+			if (!done.count(candidate.header))
+			{
+				loop = &candidate;
+				break;
+			}
+		}
+		if (loop == nullptr)
+		{
+			break;
+		}
+		done.insert(loop->header);
+		if (rotate(*loop))
+		{
+			// Le corps devient l'en-tête de la boucle tournée
+			done.insert(loop->header->exit_true);
+			rotated++;
+		}
+	}
+	return rotated;
+}
+
+bool LoopRotation::rotate(Loop &loop)
+{
+	BasicBlock *header = loop.header;
+	if (header->label == cfg->label || header->instrs.empty() || header->instrs.back()->op != IRInstr::if_comp
+		|| header->instrs.size() > maxConditionSize || loop.latches.size() != 1)
+	{
+		return false;
+	}
+	BasicBlock *body = header->exit_true;
+	BasicBlock *exit = header->exit_false;
+	BasicBlock *latch = loop.latches[0];
+	if (body == header || !loop.contains.count(body) || exit == nullptr || loop.contains.count(exit) || exit->label == "epilogue"
+		|| latch == header || latch->exit_false != nullptr || latch->exit_true != header)
+	{
+		return false;
+	}
+
+	// Les temporaires de la condition ne doivent pas être lus ailleurs : la copie en définit de nouveaux
+	unordered_map<int, int> renamed;
+	for (auto &instr : header->instrs)
+	{
+		int def = instr->get_def();
+		if (def != -1 && cfg->get_symbol(def)->isTemporary())
+		{
+			renamed[def] = -1;
+		}
+	}
+	for (auto &bb : cfg->get_bbs())
+	{
+		if (bb == header)
+		{
+			continue;
+		}
+		for (auto &instr : bb->instrs)
+		{
+			for (int var : instr->get_uses())
+			{
+				if (var != -1 && renamed.count(var))
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	for (auto &instr : header->instrs)
+	{
+		IRInstr *copy = cfg->create_instr(latch, instr->op, *instr->type, instr->params, instr->scope);
+		vector<int> uses = copy->get_uses();
+		for (int i = 0; i < uses.size(); i++)
+		{
+			if (uses[i] != -1 && renamed.count(uses[i]))
+			{
+				copy->set_use_operand(i, renamed[uses[i]]);
+			}
+		}
+		int def = copy->get_def();
+		if (def != -1 && renamed.count(def))
+		{
+			renamed[def] = cfg->create_new_temp("rot");
+			copy->set_def_operand(0, renamed[def]);
+		}
+		latch->instrs.push_back(copy);
+	}
+	latch->exit_true = body;
+	latch->exit_false = exit;
+	layout(loop, latch, exit);
+	return true;
+}
+
+void LoopRotation::layout(Loop &loop, BasicBlock *latch, BasicBlock *exit)
+{
+	// Garde, blocs de la boucle dans leur ordre actuel, bloc de test, puis sortie
+	vector<BasicBlock *> &bbs = cfg->get_bbs();
+	vector<BasicBlock *> moved;
+	for (auto &bb : bbs)
+	{
+		if (bb != loop.header && bb != latch && loop.contains.count(bb))
+		{
+			moved.push_back(bb);
+		}
+	}
+	moved.push_back(latch);
+	moved.push_back(exit);
+	unordered_set<BasicBlock *> isMoved(moved.begin(), moved.end());
+	vector<BasicBlock *> ordered;
+	for (auto &bb : bbs)
+	{
+		if (isMoved.count(bb))
+		{
+			continue;
+		}
+		ordered.push_back(bb);
+		if (bb == loop.header)
+		{
+			ordered.insert(ordered.end(), moved.begin(), moved.end());
+		}
+	}
+	bbs = ordered;
+}
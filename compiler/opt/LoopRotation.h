@@ -0,0 +1,35 @@
+#ifndef LOOP_ROTATION_H
+#define LOOP_ROTATION_H
+
+#include "../back/IR.h"
+#include "NaturalLoops.h"
+
+using namespace std;
+
+/** Rotation des boucles while en do-while gardé.
+
+	Le bloc de condition d'un while (whileN) est exécuté à chaque tour, puis le corps revient sur
+	lui par un saut inconditionnel : deux sauts par itération. La rotation recopie le calcul de
+	la condition à la fin du dernier bloc du corps, qui saute directement au début du corps tant
+	qu'elle est vraie. Le bloc whileN ne sert plus que de garde, exécuté une fois à l'entrée.
+
+	Les blocs de la boucle sont ensuite rangés à la suite de la garde, le bloc de test en dernier
+	et la sortie juste après lui : chaque itération ne paie qu'un saut conditionnel arrière.
+	Les temporaires de la copie sont renommés pour que chaque condition reste fusionnée avec son saut.
+*/
+class LoopRotation
+{
+public:
+	LoopRotation(CFG *cfg);
+
+	/** Renvoie le nombre de boucles tournées */
+	int run();
+
+private:
+	bool rotate(Loop &loop);
+	void layout(Loop &loop, BasicBlock *latch, BasicBlock *exit);
+
+	CFG *cfg;
+};
+
+#endif
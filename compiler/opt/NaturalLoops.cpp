@@ -0,0 +1,110 @@
+#include "NaturalLoops.h"
+
+#include <algorithm>
+
+NaturalLoops::NaturalLoops(CFG *cfg) : dom(cfg)
+{
+	int nbBlocks = dom.blocks.size();
+	vector<int> loopOf(nbBlocks, -1);
+	for (int t = 0; t < nbBlocks; t++)
+	{
+		for (int h : dom.succs[t])
+		{
+			if (!dom.dominates(h, t))
+			{
+				continue;
+			}
+			if (loopOf[h] == -1)
+			{
+				loopOf[h] = loops.size();
+				loops.push_back(Loop());
+				loops.back().header = dom.blocks[h];
+			}
+			Loop &loop = loops[loopOf[h]];
+			loop.latches.push_back(dom.blocks[t]);
+
+			// Remontée des prédécesseurs depuis l'origine de l'arc retour jusqu'à l'en-tête
+			vector<bool> inLoop(nbBlocks, false);
+			for (auto &bb : loop.contains)
+			{
+				inLoop[dom.blockIndex[bb]] = true;
+			}
+			inLoop[h] = true;
+			vector<int> stack;
+			if (!inLoop[t])
+			{
+				inLoop[t] = true;
+				stack.push_back(t);
+			}
+			while (!stack.empty())
+			{
+				int b = stack.back();
+				stack.pop_back();
+				for (int p : dom.preds[b])
+				{
+					if (!inLoop[p])
+					{
+						inLoop[p] = true;
+						stack.push_back(p);
+					}
+				}
+			}
+			loop.blocks.clear();
+			loop.contains.clear();
+			for (int b = 0; b < nbBlocks; b++)
+			{
+				if (inLoop[b])
+				{
+					loop.blocks.push_back(dom.blocks[b]);
+					loop.contains.insert(dom.blocks[b]);
+				}
+			}
+		}
+	}
+
+	for (auto &loop : loops)
+	{
+		for (auto &bb : loop.blocks)
+		{
+			for (BasicBlock *succ : {bb->exit_true, bb->exit_false})
+			{
+				if (succ != nullptr && !loop.contains.count(succ))
+				{
+					loop.exits.push_back({bb, succ});
+				}
+			}
+		}
+	}
+	stable_sort(loops.begin(), loops.end(), [](const Loop &a, const Loop &b) { return a.blocks.size() < b.blocks.size(); });
+}
+
+BasicBlock *NaturalLoops::insert_preheader(CFG *cfg, Loop &loop)
+{
+	vector<BasicBlock *> &bbs = cfg->get_bbs();
+	int count = 0;
+	for (auto &bb : bbs)
+	{
+		count += bb->label.find("_preheader") != string::npos;
+	}
+	BasicBlock *preheader = cfg->create_bb(cfg->label + "_preheader" + to_string(count + 1), loop.header->scope);
+	preheader->exit_true = loop.header;
+	preheader->exit_false = nullptr;
+	for (auto &bb : bbs)
+	{
+		if (bb->label == "prologue" || bb->label == "epilogue" || loop.contains.count(bb))
+		{
+			continue;
+		}
+		if (bb->exit_true == loop.header)
+		{
+			bb->exit_true = preheader;
+		}
+		if (bb->exit_false == loop.header)
+		{
+			bb->exit_false = preheader;
+		}
+	}
+	// Placé juste avant l'en-tête dans l'ordre d'émission
+	bbs.insert(find(bbs.begin(), bbs.end(), loop.header), preheader);
+	return preheader;
+}
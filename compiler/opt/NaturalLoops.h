@@ -0,0 +1,40 @@
+#ifndef NATURAL_LOOPS_H
+#define NATURAL_LOOPS_H
+
+#include <vector>
+#include <unordered_set>
+
+#include "../back/IR.h"
+#include "DominatorTree.h"
+
+using namespace std;
+
+/** Boucle naturelle : un en-tête et les blocs qui peuvent revenir à lui sans le traverser */
+struct Loop
+{
+	BasicBlock *header;
+	vector<BasicBlock *> blocks;			/**< blocs de la boucle, en-tête compris, en ordre postfixe inverse */
+	unordered_set<BasicBlock *> contains;
+	vector<BasicBlock *> latches;			/**< origines des arcs retour vers l'en-tête */
+	vector<pair<BasicBlock *, BasicBlock *>> exits; /**< arcs qui quittent la boucle (l'épilogue compris) */
+};
+
+/** Boucles naturelles d'un CFG, trouvées grâce aux arcs retour (t -> h avec h qui domine t).
+
+	Les boucles de même en-tête sont réunies. loops est trié de la plus petite à la plus grande :
+	une boucle interne passe toujours avant celles qui la contiennent.
+*/
+class NaturalLoops
+{
+public:
+	NaturalLoops(CFG *cfg);
+
+	/** Ajoute avant l'en-tête un bloc vide par lequel passent tous les arcs qui entrent dans la
+		boucle sans être des arcs retour, et le renvoie */
+	static BasicBlock *insert_preheader(CFG *cfg, Loop &loop);
+
+	DominatorTree dom;
+	vector<Loop> loops;
+};
+
+#endif
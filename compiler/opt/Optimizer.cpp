@@ -0,0 +1,61 @@
+#include "Optimizer.h"
+#include "ConstantPropagation.h"
+#include "SSA.h"
+#include "GlobalValueNumbering.h"
+#include "CFGSimplifier.h"
+#include "LoopInvariantCodeMotion.h"
+#include "LoopRotation.h"
+#include "TailCallElimination.h"
+
+Optimizer::Optimizer(CFG *cfg, bool rotateLoops) : cfg(cfg), rotateLoops(rotateLoops)
+{
+}
+
+void Optimizer::run()
+{
+	// Une récursion terminale devient une boucle, que les passes suivantes optimisent comme les autres
+	TailCallElimination tailCalls(cfg);
+	stats.push_back({"appels terminaux éliminés", tailCalls.run()});
+
+	ConstantPropagation constants(cfg);
+	constants.run();
+
+	// Les branches repliées par la propagation laissent des blocs morts et des sauts inutiles
+	CFGSimplifier simplifier(cfg);
+	simplifier.run();
+
+	LoopInvariantCodeMotion licm(cfg);
+	stats.push_back({"instructions sorties des boucles (LICM)", licm.run()});
+
+	if (rotateLoops)
+	{
+		LoopRotation rotation(cfg);
+		stats.push_back({"boucles tournées en do-while", rotation.run()});
+	}
+
+	// Les passes globales travaillent sur la forme SSA, dont on sort avant l'émission x86
+	SSA ssa(cfg);
+	ssa.construct();
+
+	GlobalValueNumbering gvn(cfg);
+	stats.push_back({"instructions redondantes éliminées (GVN)", gvn.run()});
+
+	// En SSA, chaque version d'une variable est une définition distincte : une écriture écrasée est morte
+	simplifier.remove_dead_code();
+
+	ssa.destruct();
+	stats.push_back({"copies fusionnées en sortie de SSA", ssa.get_coalesced_copies()});
+
+	// Les blocs intermédiaires gardés pour les copies peuvent encore être fusionnés
+	simplifier.run();
+	stats.push_back({"blocs supprimés ou fusionnés", simplifier.get_removed_blocks()});
+	stats.push_back({"instructions mortes supprimées", simplifier.get_removed_instrs()});
+}
+
+void Optimizer::print_stats(ostream &o)
+{
+	for (auto &stat : stats)
+	{
+		o << cfg->label << ": " << stat.second << " " << stat.first << endl;
+	}
+}
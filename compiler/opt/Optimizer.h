@@ -0,0 +1,23 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include "../back/IR.h"
+
+/** Enchaîne les passes d'optimisation indépendantes de la cible sur le CFG d'une fonction.
+	Le CFG doit être exempt d'erreurs (CFG::check_errors). */
+class Optimizer
+{
+public:
+	Optimizer(CFG *cfg, bool rotateLoops = true);
+	void run();
+
+	/** Affiche ce que chaque passe a fait (option --stats) */
+	void print_stats(ostream &o);
+
+private:
+	CFG *cfg;
+	bool rotateLoops;
+	vector<pair<string, int>> stats; /**< (description, nombre) pour chaque passe */
+};
+
+#endif
@@ -0,0 +1,93 @@
+#include "ReachingDefinitions.h"
+
+int ReachingDefinitions::count_definitions(CFG *cfg)
+{
+	int nbDefinitions = 0;
+	for (auto &bb : cfg->get_bbs())
+	{
+		for (auto &instr : bb->instrs)
+		{
+			for (int var : instr->get_defs())
+			{
+				if (var != -1)
+				{
+					nbDefinitions++;
+				}
+			}
+		}
+	}
+	return nbDefinitions;
+}
+
+ReachingDefinitions::ReachingDefinitions(CFG *cfg) : GenKillAnalysis(cfg, count_definitions(cfg), forward, meet_union)
+{
+	varDefinitions.assign(cfg->get_nb_symbols(), vector<int>());
+	for (int b = 0; b < graph.blocks.size(); b++)
+	{
+		firstDefinition.push_back(definitions.size());
+		vector<IRInstr *> &instrs = graph.blocks[b]->instrs;
+		for (int i = 0; i < instrs.size(); i++)
+		{
+			for (int var : instrs[i]->get_defs())
+			{
+				if (var != -1)
+				{
+					varDefinitions[var].push_back(definitions.size());
+					definitions.push_back({instrs[i], var});
+					defBlock.push_back(b);
+					defPosition.push_back(i);
+				}
+			}
+		}
+	}
+	firstDefinition.push_back(definitions.size());
+}
+
+void ReachingDefinitions::run()
+{
+	// gen : dernière définition de chaque variable dans le bloc ; kill : toutes les définitions des variables écrites
+	vector<int> last(varDefinitions.size(), -1);
+	for (int b = 0; b < graph.blocks.size(); b++)
+	{
+		for (int d = firstDefinition[b]; d < firstDefinition[b + 1]; d++)
+		{
+			last[definitions[d].second] = d;
+		}
+		for (int d = firstDefinition[b]; d < firstDefinition[b + 1]; d++)
+		{
+			int var = definitions[d].second;
+			if (last[var] == -1)
+			{
+				continue;
+			}
+			for (int other : varDefinitions[var])
+			{
+				kill[b].set(other);
+			}
+			gen[b].set(last[var]);
+			last[var] = -1;
+		}
+	}
+	solve();
+}
+
+vector<int> ReachingDefinitions::reaching(int block, int index, int var)
+{
+	// Une définition de var plus haut dans le bloc masque toutes celles qui arrivent au début du bloc
+	for (int d = firstDefinition[block + 1] - 1; d >= firstDefinition[block]; d--)
+	{
+		if (defPosition[d] < index && definitions[d].second == var)
+		{
+			return {d};
+		}
+	}
+	vector<int> result;
+	for (int d : varDefinitions[var])
+	{
+		if (in[block][d])
+		{
+			result.push_back(d);
+		}
+	}
+	return result;
+}
@@ -0,0 +1,37 @@
+#ifndef REACHING_DEFINITIONS_H
+#define REACHING_DEFINITIONS_H
+
+#include <vector>
+
+#include "../back/IR.h"
+#include "../back/DataFlow.h"
+
+using namespace std;
+
+/** Définitions qui atteignent chaque point d'un CFG (analyse en avant, union).
+
+	Chaque écriture d'une variable par une instruction est une définition, numérotée dans
+	definitions. in[b] contient les définitions qui atteignent le début du bloc b : celles dont
+	il existe un chemin jusqu'au bloc sans autre écriture de la même variable.
+*/
+class ReachingDefinitions : public GenKillAnalysis
+{
+public:
+	ReachingDefinitions(CFG *cfg);
+
+	void run();
+
+	/** Définitions de var qui atteignent l'instruction numéro index du bloc */
+	vector<int> reaching(int block, int index, int var);
+
+	vector<pair<IRInstr *, int>> definitions; /**< (instruction, variable écrite) */
+	vector<vector<int>> varDefinitions;		  /**< définitions de chaque variable */
+	vector<int> defBlock;					  /**< bloc de chaque définition */
+	vector<int> defPosition;				  /**< rang de l'instruction de chaque définition dans son bloc */
+	vector<int> firstDefinition;			  /**< les définitions du bloc b sont numérotées de firstDefinition[b] à firstDefinition[b+1] exclu */
+
+private:
+	static int count_definitions(CFG *cfg);
+};
+
+#endif
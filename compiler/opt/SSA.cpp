@@ -0,0 +1,475 @@
+#include "SSA.h"
+#include "../back/Liveness.h"
+#include "NaturalLoops.h"
+
+#include <unordered_set>
+#include <algorithm>
+
+// Portée racine de la fonction (countBlock = 1 dans buildIR::visitFunction) : les temporaires y sont
+// rangés, ce qui les rend visibles depuis n'importe quelle instruction
+static const int rootScope = 1;
+
+SSA::SSA(CFG *cfg) : cfg(cfg), coalescedCopies(0)
+{
+}
+
+int SSA::get_coalesced_copies()
+{
+	return coalescedCopies;
+}
+
+int SSA::new_name(int var)
+{
+	// Le temporaire porte le nom de la variable qu'il renomme
+	return cfg->create_new_temp(cfg->get_symbol(var)->getName());
+}
+
+void SSA::construct()
+{
+	nbVars = cfg->get_nb_symbols();
+	promoted.assign(nbVars, false);
+	for (int var = 0; var < nbVars; var++)
+	{
+		promoted[var] = !cfg->get_symbol(var)->isTemporary();
+	}
+
+	DominatorTree dom(cfg);
+	if (dom.blocks.empty())
+	{
+		return;
+	}
+	place_phis(dom);
+	rename(dom);
+}
+
+void SSA::place_phis(DominatorTree &dom)
+{
+	// Un phi n'est utile que là où la variable est vivante (SSA élaguée)
+	Liveness liveness(cfg);
+	liveness.run();
+
+	int nbBlocks = dom.blocks.size();
+	vector<vector<int>> defBlocks(nbVars);
+	for (int b = 0; b < nbBlocks; b++)
+	{
+		for (auto &instr : dom.blocks[b]->instrs)
+		{
+			for (int var : instr->get_defs())
+			{
+				if (var != -1 && promoted[var] && (defBlocks[var].empty() || defBlocks[var].back() != b))
+				{
+					defBlocks[var].push_back(b);
+				}
+			}
+		}
+	}
+
+	vector<int> hasPhi(nbBlocks, -1), onWorklist(nbBlocks, -1);
+	vector<vector<IRInstr *>> phis(nbBlocks);
+	for (int var = 0; var < nbVars; var++)
+	{
+		vector<int> worklist = defBlocks[var];
+		for (int b : worklist)
+		{
+			onWorklist[b] = var;
+		}
+		while (!worklist.empty())
+		{
+			int b = worklist.back();
+			worklist.pop_back();
+			for (int y : dom.frontier[b])
+			{
+				BasicBlock *bb = dom.blocks[y];
+				if (hasPhi[y] == var || !liveness.liveIn[liveness.blockIndex[bb]][var])
+				{
+					continue;
+				}
+				hasPhi[y] = var;
+				IRInstr *phi = cfg->create_instr(bb, IRInstr::phi, "int", vector<IROperand>(dom.preds[y].size() + 1, IROperand::variable(var)), rootScope);
+				for (int p : dom.preds[y])
+				{
+					phi->phiBlocks.push_back(dom.blocks[p]);
+				}
+				phiVar[phi] = var;
+				phis[y].push_back(phi);
+				if (onWorklist[y] != var)
+				{
+					onWorklist[y] = var;
+					worklist.push_back(y);
+				}
+			}
+		}
+	}
+	for (int b = 0; b < nbBlocks; b++)
+	{
+		vector<IRInstr *> &instrs = dom.blocks[b]->instrs;
+		instrs.insert(instrs.begin(), phis[b].begin(), phis[b].end());
+	}
+}
+
+void SSA::rename(DominatorTree &dom)
+{
+	stacks.assign(nbVars, vector<int>());
+	undefined.assign(nbVars, -1);
+	auto current = [&](int var) {
+		if (!stacks[var].empty())
+		{
+			return stacks[var].back();
+		}
+		if (undefined[var] == -1)
+		{
+			undefined[var] = new_name(var);
+		}
+		return undefined[var];
+	};
+
+	// Parcours en profondeur de l'arbre des dominateurs ; pushed[b] liste les noms à dépiler en sortant de b
+	vector<vector<int>> pushed(dom.blocks.size());
+	vector<pair<int, int>> stack = {{0, 0}};
+	while (!stack.empty())
+	{
+		int b = stack.back().first;
+		int child = stack.back().second++;
+		if (child == 0)
+		{
+			BasicBlock *bb = dom.blocks[b];
+			for (auto &instr : bb->instrs)
+			{
+				if (instr->op != IRInstr::phi)
+				{
+					vector<int> uses = instr->get_uses();
+					for (int i = 0; i < uses.size(); i++)
+					{
+						if (uses[i] != -1 && promoted[uses[i]])
+						{
+							instr->set_use_operand(i, current(uses[i]));
+						}
+					}
+				}
+				vector<int> defs = instr->op == IRInstr::phi ? vector<int>{phiVar[instr]} : instr->get_defs();
+				for (int i = 0; i < defs.size(); i++)
+				{
+					if (defs[i] != -1 && promoted[defs[i]])
+					{
+						int name = new_name(defs[i]);
+						instr->set_def_operand(i, name);
+						stacks[defs[i]].push_back(name);
+						pushed[b].push_back(defs[i]);
+					}
+				}
+			}
+			// Arguments des phi des successeurs pour l'arc venant de b
+			for (int s : dom.succs[b])
+			{
+				for (auto &instr : dom.blocks[s]->instrs)
+				{
+					if (instr->op != IRInstr::phi)
+					{
+						break;
+					}
+					for (int j = 0; j < instr->phiBlocks.size(); j++)
+					{
+						if (instr->phiBlocks[j] == bb)
+						{
+							instr->params[j + 1] = IROperand::variable(current(phiVar[instr]));
+						}
+					}
+				}
+			}
+		}
+		if (child < dom.children[b].size())
+		{
+			stack.push_back({dom.children[b][child], 0});
+		}
+		else
+		{
+			for (int var : pushed[b])
+			{
+				stacks[var].pop_back();
+			}
+			stack.pop_back();
+		}
+	}
+}
+
+void SSA::destruct()
+{
+	split_critical_edges();
+	eliminate_phis();
+	coalesce_copies();
+
+	// Un bloc intermédiaire dont toutes les copies ont été fusionnées ne sert plus à rien
+	vector<BasicBlock *> &bbs = cfg->get_bbs();
+	for (auto &split : splits)
+	{
+		if (!split.second->instrs.empty())
+		{
+			continue;
+		}
+		if (split.first->exit_true == split.second)
+		{
+			split.first->exit_true = split.second->exit_true;
+		}
+		if (split.first->exit_false == split.second)
+		{
+			split.first->exit_false = split.second->exit_true;
+		}
+		bbs.erase(find(bbs.begin(), bbs.end(), split.second));
+	}
+}
+
+void SSA::split_critical_edges()
+{
+	NaturalLoops natural(cfg);
+	vector<BasicBlock *> &bbs = cfg->get_bbs();
+	for (int i = 0; i < bbs.size(); i++)
+	{
+		BasicBlock *bb = bbs[i];
+		if (bb->instrs.empty() || bb->instrs[0]->op != IRInstr::phi)
+		{
+			continue;
+		}
+		// Les phi d'un bloc ont tous les mêmes prédécesseurs, dans le même ordre
+		vector<BasicBlock *> preds = bb->instrs[0]->phiBlocks;
+		for (int j = 0; j < preds.size(); j++)
+		{
+			BasicBlock *pred = preds[j];
+			if (pred->exit_false == nullptr || (pred->exit_true != bb && pred->exit_false != bb))
+			{
+				continue;
+			}
+			// Les copies vont vers un nom propre au phi, qui n'est vivant que vers bb : elles peuvent rester
+			// dans un prédécesseur à deux successeurs. On ne coupe que les arcs qui sortent d'une boucle,
+			// pour ne pas exécuter à chaque tour des copies qui ne servent qu'à la sortie
+			bool leavesLoop = false;
+			for (auto &loop : natural.loops)
+			{
+				leavesLoop = leavesLoop || (loop.contains.count(pred) && !loop.contains.count(bb));
+			}
+			if (!leavesLoop)
+			{
+				continue;
+			}
+			BasicBlock *split = cfg->create_bb(cfg->label + "_split" + to_string(splits.size() + 1), pred->scope);
+			splits.push_back({pred, split});
+			split->exit_true = bb;
+			split->exit_false = nullptr;
+			if (pred->exit_true == bb)
+			{
+				pred->exit_true = split;
+			}
+			if (pred->exit_false == bb)
+			{
+				pred->exit_false = split;
+			}
+			for (int p = 0; p < bbs.size(); p++)
+			{
+				if (bbs[p] == pred)
+				{
+					bbs.insert(bbs.begin() + p + 1, split);
+					if (p < i)
+					{
+						i++;
+					}
+					break;
+				}
+			}
+			for (auto &instr : bb->instrs)
+			{
+				if (instr->op != IRInstr::phi)
+				{
+					break;
+				}
+				for (auto &phiBlock : instr->phiBlocks)
+				{
+					if (phiBlock == pred)
+					{
+						phiBlock = split;
+					}
+				}
+			}
+		}
+	}
+}
+
+void SSA::eliminate_phis()
+{
+	for (auto &bb : cfg->get_bbs())
+	{
+		// Les phi sont en tête de bloc ; les copies ajoutées en fin de bloc ne les déplacent pas
+		for (int k = 0; k < bb->instrs.size() && bb->instrs[k]->op == IRInstr::phi; k++)
+		{
+			IRInstr *phi = bb->instrs[k];
+			// Chaque phi passe par un nom propre : les copies insérées dans les prédécesseurs
+			// ne peuvent pas écraser l'argument d'un autre phi du même bloc
+			int joined = cfg->create_new_temp("phi");
+			for (int j = 0; j < phi->phiBlocks.size(); j++)
+			{
+				BasicBlock *pred = phi->phiBlocks[j];
+				IRInstr *copy = cfg->create_instr(pred, IRInstr::copy, "int", {IROperand::variable(joined), phi->params[j + 1]}, rootScope);
+				// Les copies passent avant le test de fin de bloc, et avant le calcul de sa condition
+				// pour qu'elle reste fusionnée avec le saut
+				int position = pred->instrs.size();
+				if (position > 0 && pred->instrs.back()->op == IRInstr::if_comp)
+				{
+					int condition = pred->instrs.back()->get_uses()[0];
+					position--;
+					IRInstr *previous = position > 0 ? pred->instrs[position - 1] : nullptr;
+					bool comparison = previous != nullptr && (previous->op == IRInstr::cmp_eq || previous->op == IRInstr::cmp_ne || previous->op == IRInstr::cmp_lt || previous->op == IRInstr::cmp_le || previous->op == IRInstr::copy_not);
+					if (comparison && condition != -1 && previous->get_def() == condition && copy->get_uses()[0] != condition)
+					{
+						position--;
+					}
+				}
+				pred->instrs.insert(pred->instrs.begin() + position, copy);
+			}
+			bb->instrs[k] = cfg->create_instr(bb, IRInstr::copy, "int", {phi->params[0], IROperand::variable(joined)}, rootScope);
+		}
+	}
+}
+
+void SSA::coalesce_copies()
+{
+	Liveness liveness(cfg);
+	liveness.run();
+	int nbSymbols = cfg->get_nb_symbols();
+
+	// Graphe d'interférence : une définition interfère avec tout ce qui est vivant après elle,
+	// sauf avec la source quand il s'agit d'une copie
+	vector<unordered_set<int>> interference(nbSymbols);
+	vector<int> live, position(nbSymbols, -1);
+	auto add_live = [&](int var) {
+		if (var != -1 && position[var] == -1)
+		{
+			position[var] = live.size();
+			live.push_back(var);
+		}
+	};
+	auto remove_live = [&](int var) {
+		if (var != -1 && position[var] != -1)
+		{
+			int last = live.back();
+			live[position[var]] = last;
+			position[last] = position[var];
+			live.pop_back();
+			position[var] = -1;
+		}
+	};
+	for (int b = 0; b < liveness.order.size(); b++)
+	{
+		liveness.liveOut[b].for_each(add_live);
+		vector<IRInstr *> &instrs = liveness.order[b]->instrs;
+		for (int i = instrs.size() - 1; i >= 0; i--)
+		{
+			vector<int> defs = instrs[i]->get_defs();
+			vector<int> uses = instrs[i]->get_uses();
+			int source = instrs[i]->op == IRInstr::copy ? uses[0] : -1;
+			for (int def : defs)
+			{
+				if (def == -1)
+				{
+					continue;
+				}
+				for (int var : live)
+				{
+					if (var != def && var != source)
+					{
+						interference[def].insert(var);
+						interference[var].insert(def);
+					}
+				}
+				for (int other : defs)
+				{
+					if (other != -1 && other != def)
+					{
+						interference[def].insert(other);
+					}
+				}
+			}
+			for (int def : defs)
+			{
+				remove_live(def);
+			}
+			for (int use : uses)
+			{
+				add_live(use);
+			}
+		}
+		while (!live.empty())
+		{
+			remove_live(live.back());
+		}
+	}
+
+	// Fusion des deux côtés d'une copie entre temporaires (tous visibles depuis la portée racine)
+	vector<int> representative(nbSymbols);
+	for (int var = 0; var < nbSymbols; var++)
+	{
+		representative[var] = var;
+	}
+	auto find = [&](int var) {
+		while (representative[var] != var)
+		{
+			representative[var] = representative[representative[var]];
+			var = representative[var];
+		}
+		return var;
+	};
+	for (auto &bb : cfg->get_bbs())
+	{
+		for (auto &instr : bb->instrs)
+		{
+			vector<int> uses = instr->get_uses();
+			int def = instr->get_def();
+			if (instr->op != IRInstr::copy || def == -1 || uses[0] == -1)
+			{
+				continue;
+			}
+			int a = find(def), b = find(uses[0]);
+			if (a == b || !cfg->get_symbol(a)->isTemporary() || !cfg->get_symbol(b)->isTemporary() || interference[a].count(b))
+			{
+				continue;
+			}
+			for (int neighbour : interference[b])
+			{
+				interference[neighbour].erase(b);
+				interference[neighbour].insert(a);
+				interference[a].insert(neighbour);
+			}
+			interference[b].clear();
+			representative[b] = a;
+		}
+	}
+
+	// Réécriture des opérandes, puis suppression des copies devenues x = x
+	for (auto &bb : cfg->get_bbs())
+	{
+		vector<IRInstr *> kept;
+		for (auto &instr : bb->instrs)
+		{
+			vector<int> uses = instr->get_uses();
+			vector<int> defs = instr->get_defs();
+			for (int i = 0; i < uses.size(); i++)
+			{
+				if (uses[i] != -1 && find(uses[i]) != uses[i])
+				{
+					instr->set_use_operand(i, find(uses[i]));
+				}
+			}
+			for (int i = 0; i < defs.size(); i++)
+			{
+				if (defs[i] != -1 && find(defs[i]) != defs[i])
+				{
+					instr->set_def_operand(i, find(defs[i]));
+				}
+			}
+			if (instr->op == IRInstr::copy && uses[0] != -1 && defs[0] != -1 && find(uses[0]) == find(defs[0]))
+			{
+				coalescedCopies++;
+				continue;
+			}
+			kept.push_back(instr);
+		}
+		bb->instrs = kept;
+	}
+}
@@ -0,0 +1,56 @@
+#ifndef SSA_H
+#define SSA_H
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+#include "../back/IR.h"
+#include "DominatorTree.h"
+
+using namespace std;
+
+/** Passage en forme SSA (mem2reg) et retour, pour le CFG d'une fonction.
+
+	construct() promeut les variables locales et les paramètres : chaque définition reçoit un nom
+	de temporaire unique, et un phi est placé dans les blocs de jonction (endif*, while*) de la
+	frontière de dominance itérée où la variable est vivante. Une lecture sans définition
+	(variable non initialisée) utilise un nom jamais écrit, qui garde donc sa case mémoire.
+
+	destruct() rend un CFG que le back-end x86 sait émettre : chaque phi devient des copies vers un
+	nom propre à la fin de ses prédécesseurs, avant leur saut, puis une copie de ce nom en tête du
+	bloc. Seuls les arcs critiques qui sortent d'une boucle sont coupés, pour que les copies de la
+	sortie ne soient pas faites à chaque tour. Les noms reliés par une copie et qui n'interfèrent
+	pas sont ensuite fusionnés (coalescing), ce qui supprime la copie.
+*/
+class SSA
+{
+public:
+	SSA(CFG *cfg);
+
+	void construct();
+	void destruct();
+
+	/** Nombre de copies supprimées par le coalescing */
+	int get_coalesced_copies();
+
+private:
+	void place_phis(DominatorTree &dom);
+	void rename(DominatorTree &dom);
+	int new_name(int var); /**< nouveau temporaire pour une définition de var, renvoie son numéro */
+
+	void split_critical_edges();
+	void eliminate_phis();
+	void coalesce_copies();
+
+	CFG *cfg;
+	int nbVars;						   /**< nombre de symboles avant le passage en SSA */
+	vector<bool> promoted;
+	unordered_map<IRInstr *, int> phiVar; /**< variable d'origine de chaque phi */
+	vector<vector<int>> stacks;		   /**< nom courant de chaque variable pendant le renommage */
+	vector<int> undefined;			   /**< nom utilisé pour une lecture sans définition, -1 avant la première */
+	vector<pair<BasicBlock *, BasicBlock *>> splits; /**< arcs critiques coupés : (prédécesseur, bloc intermédiaire) */
+	int coalescedCopies;
+};
+
+#endif
@@ -0,0 +1,95 @@
+#include "TailCallElimination.h"
+
+#include <algorithm>
+
+TailCallElimination::TailCallElimination(CFG *cfg) : cfg(cfg), body(nullptr)
+{
+}
+
+BasicBlock *TailCallElimination::body_block()
+{
+	if (body != nullptr)
+	{
+		return body;
+	}
+	// Le bloc d'entrée ne garde que la réception des paramètres ; le reste devient l'en-tête de la boucle
+	vector<BasicBlock *> &bbs = cfg->get_bbs();
+	auto position = find_if(bbs.begin(), bbs.end(), [&](BasicBlock *bb) { return bb->label == cfg->label; });
+	BasicBlock *entry = *position;
+	body = cfg->create_bb(cfg->label + "_tailrec", entry->scope);
+	body->exit_true = entry->exit_true;
+	body->exit_false = entry->exit_false;
+	int start = !entry->instrs.empty() && entry->instrs[0]->op == IRInstr::function_params_initialisation;
+	for (int i = start; i < entry->instrs.size(); i++)
+	{
+		entry->instrs[i]->bb = body;
+		body->instrs.push_back(entry->instrs[i]);
+	}
+	entry->instrs.resize(start);
+	entry->exit_true = body;
+	entry->exit_false = nullptr;
+	bbs.insert(position + 1, body);
+	return body;
+}
+
+int TailCallElimination::run()
+{
+	IRInstr *paramsInit = nullptr;
+	vector<IRInstr *> calls;
+	for (auto &bb : cfg->get_bbs())
+	{
+		vector<IRInstr *> &instrs = bb->instrs;
+		if (bb->label == cfg->label && !instrs.empty() && instrs[0]->op == IRInstr::function_params_initialisation)
+		{
+			paramsInit = instrs[0];
+		}
+		if (bb->exit_true == nullptr || bb->exit_true->label != "epilogue" || instrs.size() < 2)
+		{
+			continue;
+		}
+		IRInstr *call = instrs[instrs.size() - 2];
+		IRInstr *ret = instrs.back();
+		if (call->op == IRInstr::call && ret->op == IRInstr::ret && call->get_def() != -1 && ret->get_uses()[0] == call->get_def())
+		{
+			calls.push_back(call);
+		}
+	}
+
+	vector<IROperand> params = paramsInit != nullptr ? paramsInit->params : vector<IROperand>();
+	int nbEliminated = 0;
+	for (auto &call : calls)
+	{
+		if (call->params[1].get_label() == cfg->label && call->params.size() - 2 == params.size())
+		{
+			// La coupure du bloc d'entrée peut déplacer l'appel : son bloc est relu ensuite
+			BasicBlock *target = body_block();
+			BasicBlock *bb = call->bb;
+			vector<IROperand> args(call->params.begin() + 2, call->params.end());
+			int scope = call->scope;
+			bb->instrs.pop_back();
+			bb->instrs.pop_back();
+
+			vector<IROperand> values;
+			for (int i = 0; i < args.size(); i++)
+			{
+				values.push_back(IROperand::variable(cfg->create_new_temp("tail")));
+				bb->add_IRInstr(IRInstr::copy, "int", {values[i], args[i]}, scope);
+			}
+			for (int i = 0; i < args.size(); i++)
+			{
+				bb->add_IRInstr(IRInstr::copy, "int", {params[i], values[i]}, scope);
+			}
+			bb->exit_true = target;
+			nbEliminated++;
+		}
+		else if (call->params.size() - 2 <= 6)
+		{
+			// Le résultat de l'appelé reste dans %eax : il n'est plus lu ici
+			call->bb->instrs.pop_back();
+			call->op = IRInstr::tail_call;
+			call->params[0] = IROperand();
+			nbEliminated++;
+		}
+	}
+	return nbEliminated;
+}
@@ -0,0 +1,38 @@
+#ifndef TAIL_CALL_ELIMINATION_H
+#define TAIL_CALL_ELIMINATION_H
+
+#include "../back/IR.h"
+
+using namespace std;
+
+/** Élimination des appels terminaux.
+
+	Un appel dont le résultat est aussitôt renvoyé (call t, f, ... suivi de ret t) est terminal :
+	- un appel de la fonction à elle-même devient une boucle : les arguments sont copiés dans les
+	  paramètres (en passant par des temporaires, un argument pouvant lire un autre paramètre) puis
+	  le bloc saute au début du corps. Le bloc d'entrée est coupé après function_params_initialisation
+	  pour que le corps (fonction_tailrec) devienne l'en-tête de la boucle ;
+	- un autre appel devient un tail_call : les arguments sont placés dans leurs registres, le
+	  cadre de pile est rendu comme dans l'épilogue, puis jmp vers l'appelé au lieu de call et ret.
+	  Un appel avec plus de 6 arguments reste un call : les arguments passés sur la pile devraient
+	  remplacer ceux de notre appelant, dont la zone peut être plus petite.
+	La pile ne grandit plus avec la profondeur de récursion.
+
+	À lancer avant les autres optimisations, sur un CFG sans phi.
+*/
+class TailCallElimination
+{
+public:
+	TailCallElimination(CFG *cfg);
+
+	/** Renvoie le nombre d'appels terminaux remplacés */
+	int run();
+
+private:
+	BasicBlock *body_block();
+
+	CFG *cfg;
+	BasicBlock *body; /**< début du corps après la coupure du bloc d'entrée, nullptr avant */
+};
+
+#endif
@@ -0,0 +1,24 @@
+#!/bin/sh
+# Compare les boucles while avec et sans rotation en do-while (option --no-rotate de ifcc).
+# Pour chaque programme : nombre d'instructions de saut présentes dans l'assembleur (compte statique
+# sur tout le fichier, pas les sauts exécutés à chaque tour) et temps d'exécution.
+#
+#     ./bench.sh [programme.c ...]
+
+cd "$(dirname "$0")"
+. ./common.sh
+IFCC=../../compiler/ifcc
+PROGS=${*:-while_*.c}
+
+
+printf "%-18s %12s %12s %10s %10s\n" programme "sauts émis" "émis rot." "temps ms" "rot. ms"
+for prog in $PROGS; do
+    name=$(basename $prog .c)
+    $IFCC --no-rotate $prog > $name.norot.s && gcc $name.norot.s -o $name.norot 2>/dev/null || exit 1
+    $IFCC $prog > $name.rot.s && gcc $name.rot.s -o $name.rot 2>/dev/null || exit 1
+    # Nombre d'instructions de saut dans le code émis, sans tenir compte de leur exécution
+    jumps=$(grep -c "^	j" $name.norot.s)
+    jumpsRot=$(grep -c "^	j" $name.rot.s)
+    printf "%-18s %12s %12s %10s %10s\n" $name $jumps $jumpsRot $(best_time ./$name.norot) $(best_time ./$name.rot)
+    rm -f $name.norot $name.rot $name.norot.s $name.rot.s
+done
@@ -0,0 +1,39 @@
+# Fonctions communes aux scripts de mesure de ce répertoire, chargées par « . ./common.sh » après
+# s'être placé dans tests/bench.
+
+RUNS=${RUNS:-5}
+
+# Le plus petit de deux nombres, le second si le premier est vide
+smaller() {
+    if [ -z "$1" ] || [ $2 -lt $1 ]; then
+        echo $2
+    else
+        echo $1
+    fi
+}
+
+# Temps (ms) écoulé entre deux dates lues par date +%s%N
+elapsed_ms() {
+    echo $(( ($2 - $1) / 1000000 ))
+}
+
+# Meilleur temps (ms) sur $RUNS exécutions de la commande donnée, sortie standard ignorée
+best_time() {
+    best=""
+    for run in $(seq $RUNS); do
+        start=$(date +%s%N)
+        "$@" >/dev/null
+        end=$(date +%s%N)
+        best=$(smaller "$best" $(elapsed_ms $start $end))
+    done
+    echo $best
+}
+
+# « identique » si les deux fichiers (ou répertoires) ont le même contenu, « DIFFÉRENTE » sinon
+same_output() {
+    if diff -r "$1" "$2" >/dev/null; then
+        echo identique
+    else
+        echo DIFFÉRENTE
+    fi
+}
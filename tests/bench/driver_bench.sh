@@ -0,0 +1,94 @@
+#!/bin/sh
+# Compilation de nombreux fichiers : un seul processus ifcc pour tous les fichiers (le lexer et le
+# parser gardent leurs DFA d'un fichier à l'autre), avec ou sans -j, contre un processus par fichier.
+# Les fichiers sont générés ici ; l'assembleur produit est comparé entre les modes. Un fichier
+# erroné placé au milieu d'un lot ne doit faire échouer que lui-même.
+#
+#     ./driver_bench.sh [nombre de fichiers] [nombre de threads]
+
+cd "$(dirname "$0")"
+. ./common.sh
+IFCC=${IFCC:-$(pwd)/../../compiler/ifcc}
+FILES=${1:-1000}
+JOBS=${2:-4}
+DIR=driver_bench_gen
+
+# Chaque fichier : deux fonctions avec des if, des while et des appels, variées par le numéro du fichier
+generate() {
+    rm -rf $DIR
+    mkdir -p $DIR/single $DIR/batch $DIR/batch_j
+    i=0
+    while [ $i -lt $FILES ]; do
+        {
+            echo "int g(int a, int b) {"
+            echo "    int r = a * $i - b;"
+            echo "    if (r > b) { r = r / 2 + a; } else { r = -r + $i; }"
+            echo "    return r;"
+            echo "}"
+            echo "int main() {"
+            echo "    int s = 0;"
+            echo "    int n = $((i % 17 + 3));"
+            echo "    while (n > 0) {"
+            echo "        s = s + g(n, s) * 3 - (n == 5);"
+            echo "        n = n - 1;"
+            echo "    }"
+            echo "    return s - (s / 256) * 256;"
+            echo "}"
+        } > $DIR/f$i.c
+        i=$((i + 1))
+    done
+}
+
+generate
+cd $DIR
+
+start=$(date +%s%N)
+for f in f*.c; do
+    $IFCC $f > single/${f%.c}.s || exit 1
+done
+end=$(date +%s%N)
+separate=$(elapsed_ms $start $end)
+
+# Un seul processus : chaque fichier suivi de -o vers sa sortie. Avec -j, les sorties vont dans
+# leur propre répertoire, comparé lui aussi aux sorties des processus séparés
+args=""
+argsParallel=""
+for f in f*.c; do
+    args="$args $f -o batch/${f%.c}.s"
+    argsParallel="$argsParallel $f -o batch_j/${f%.c}.s"
+done
+start=$(date +%s%N)
+$IFCC $args || exit 1
+end=$(date +%s%N)
+batch=$(elapsed_ms $start $end)
+same=$(same_output single batch)
+
+start=$(date +%s%N)
+$IFCC -j $JOBS $argsParallel || exit 1
+end=$(date +%s%N)
+parallel=$(elapsed_ms $start $end)
+sameParallel=$(same_output single batch_j)
+
+printf "%-32s %10s %10s\n" "$FILES fichiers" "temps ms" "sortie"
+printf "%-32s %10s %10s\n" "un processus par fichier" $separate -
+printf "%-32s %10s %10s\n" "un seul processus" $batch $same
+printf "%-32s %10s %10s\n" "un seul processus, -j $JOBS" $parallel $sameParallel
+
+# Un fichier erroné (fonction définie deux fois) au milieu du lot : seul ce fichier échoue, les
+# fichiers suivants sont compilés et le code de retour signale l'échec
+printf 'int g() { return 1; }\nint g() { return 2; }\nint main() { return g(); }\n' > bad.c
+for mode in "" "-j $JOBS"; do
+    rm -f batch/f0.s batch/f1.s
+    $IFCC $mode f0.c -o batch/f0.s bad.c -o batch/bad.s f1.c -o batch/f1.s 2> bad.log
+    status=$?
+    if [ $status -ne 0 ] && cmp -s single/f0.s batch/f0.s && cmp -s single/f1.s batch/f1.s \
+        && grep -q "Redéfinition de la fonction g" bad.log && grep -q "bad.c: compilation échouée" bad.log; then
+        isolated=ok
+    else
+        isolated=ÉCHEC
+    fi
+    printf "%-32s %10s %10s\n" "fichier erroné dans le lot $mode" - $isolated
+done
+
+cd ..
+rm -rf $DIR
@@ -0,0 +1,44 @@
+#!/bin/sh
+# Front-end ANTLR (par défaut) contre lexer et parser écrits à la main (--frontend=rd) : temps de
+# compilation de programmes de plus en plus longs, générés ici, sans optimisation pour que
+# l'analyse domine. L'assembleur des deux front-ends est comparé octet par octet.
+#
+#     ./frontend_bench.sh [nombre de fonctions ...]
+
+cd "$(dirname "$0")"
+. ./common.sh
+IFCC=${IFCC:-../../compiler/ifcc}
+SIZES=${*:-"100 400 1600"}
+PROG=frontend_bench_gen.c
+
+# Des fonctions aux expressions imbriquées, avec if/else, while et appels
+generate() {
+    i=0
+    while [ $i -lt $1 ]; do
+        echo "int f$i(int a, int b) {"
+        echo "    int s = $i;"
+        echo "    int t;"
+        echo "    t = (a + b) * (a - $i) / (b + 1);"
+        echo "    while (a > 0) {"
+        echo "        if (!(s == t)) { s = s + -a * 3; } else { s = s - (t / 7 + b); }"
+        echo "        a = a - 1;"
+        echo "    }"
+        echo "    return s + t;"
+        echo "}"
+        i=$((i + 1))
+    done
+    echo "int main() {"
+    echo "    return f0(10, 3) - (f0(10, 3) / 256) * 256;"
+    echo "}"
+}
+
+
+printf "%-10s %12s %12s %10s\n" fonctions "antlr ms" "rd ms" "sortie"
+for size in $SIZES; do
+    generate $size > $PROG
+    $IFCC -O0 --frontend=antlr $PROG > $PROG.antlr.s || exit 1
+    $IFCC -O0 --frontend=rd $PROG > $PROG.rd.s || exit 1
+    printf "%-10s %12s %12s %10s\n" $size $(best_time $IFCC -O0 --frontend=antlr $PROG) $(best_time $IFCC -O0 --frontend=rd $PROG) $(same_output $PROG.antlr.s $PROG.rd.s)
+    rm -f $PROG.antlr.s $PROG.rd.s
+done
+rm -f $PROG
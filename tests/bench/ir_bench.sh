@@ -0,0 +1,64 @@
+#!/bin/sh
+# Micro-benchmark de la représentation de l'IR : temps de construction de l'IR et d'émission du code
+# (lus dans la sortie de ifcc --stats) pour des fonctions de plus en plus grandes, générées ici.
+# IFCC_REF peut désigner un autre ifcc (par exemple compilé depuis une révision précédente) pour comparer.
+#
+#     [IFCC_REF=/chemin/vers/ifcc] ./ir_bench.sh [nombre d'instructions ...]
+
+cd "$(dirname "$0")"
+. ./common.sh
+IFCC=${IFCC:-../../compiler/ifcc}
+SIZES=${*:-"2000 8000 32000"}
+PROG=ir_bench_gen.c
+
+# Une seule fonction : des blocs imbriqués qui déclarent leurs variables et les combinent
+generate() {
+    echo "int main() {"
+    echo "    int a = 1;"
+    echo "    int b = 2;"
+    i=0
+    while [ $i -lt $1 ]; do
+        echo "    {"
+        echo "        int x$i = a + b * $i;"
+        echo "        int y$i = x$i - a / 3;"
+        echo "        a = (x$i + y$i) - (b * 7) / 5;"
+        echo "        b = -y$i + (a == x$i);"
+        echo "    }"
+        i=$((i + 4))
+    done
+    echo "    return a - (a / 256) * 256;"
+    echo "}"
+}
+
+# Meilleurs temps (µs) de construction et d'émission sur $RUNS compilations
+best_times() {
+    bestBuild=""
+    bestEmit=""
+    for run in $(seq $RUNS); do
+        line=$($1 --stats -O0 $PROG 2>&1 >/dev/null | grep "construction de l'IR")
+        build=$(echo "$line" | sed 's/.*IR : \([0-9]*\) .*/\1/')
+        emit=$(echo "$line" | sed 's/.*émission : \([0-9]*\) .*/\1/')
+        bestBuild=$(smaller "$bestBuild" $build)
+        bestEmit=$(smaller "$bestEmit" $emit)
+    done
+    echo $bestBuild $bestEmit
+}
+
+if [ -n "$IFCC_REF" ]; then
+    printf "%-12s %12s %12s %12s %12s\n" instructions "IR réf. µs" "IR µs" "émis réf. µs" "émis µs"
+else
+    printf "%-12s %12s %12s\n" instructions "IR µs" "émis µs"
+fi
+for size in $SIZES; do
+    generate $size > $PROG
+    set -- $(best_times $IFCC)
+    if [ -n "$IFCC_REF" ]; then
+        build=$1
+        emit=$2
+        set -- $(best_times $IFCC_REF)
+        printf "%-12s %12s %12s %12s %12s\n" $size $1 $build $2 $emit
+    else
+        printf "%-12s %12s %12s\n" $size $1 $2
+    fi
+done
+rm -f $PROG
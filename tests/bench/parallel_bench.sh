@@ -0,0 +1,44 @@
+#!/bin/sh
+# Compilation parallèle des fonctions (option -j de ifcc) : temps de compilation d'un programme
+# de nombreuses fonctions, généré ici, pour chaque nombre de threads. La sortie de chaque -j est
+# comparée octet par octet à celle de -j 1.
+#
+#     ./parallel_bench.sh [nombre de threads ...]
+
+cd "$(dirname "$0")"
+. ./common.sh
+IFCC=${IFCC:-../../compiler/ifcc}
+JOBS=${*:-"1 2 4 8"}
+FUNCTIONS=400
+PROG=parallel_bench_gen.c
+
+# Des fonctions indépendantes avec une boucle et quelques calculs, appelées par main
+generate() {
+    i=0
+    while [ $i -lt $FUNCTIONS ]; do
+        echo "int f$i(int n, int a) {"
+        echo "    int s = $i;"
+        echo "    while (n > 0) {"
+        echo "        int x = a * n + $i;"
+        echo "        if (x / 3 == s) { s = s + x; } else { s = s - x / 7; }"
+        echo "        n = n - 1;"
+        echo "    }"
+        echo "    return s;"
+        echo "}"
+        i=$((i + 1))
+    done
+    echo "int main() {"
+    echo "    return f0(10, 3) - (f0(10, 3) / 256) * 256;"
+    echo "}"
+}
+
+
+generate > $PROG
+$IFCC -j 1 $PROG > $PROG.ref.s || exit 1
+printf "%-8s %10s %10s\n" threads "temps ms" "sortie"
+for jobs in $JOBS; do
+    $IFCC -j $jobs $PROG > $PROG.$jobs.s
+    printf "%-8s %10s %10s\n" $jobs $(best_time $IFCC -j $jobs $PROG) $(same_output $PROG.ref.s $PROG.$jobs.s)
+    rm -f $PROG.$jobs.s
+done
+rm -f $PROG $PROG.ref.s
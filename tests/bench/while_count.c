@@ -0,0 +1,11 @@
+int main() {
+    int x = 0;
+    int n = 0;
+    while (x != 300000000) {
+        if (x - (x / 3) * 3 == 0) {
+            n = n + 1;
+        }
+        x = x + 1;
+    }
+    return n - (n / 256) * 256;
+}
@@ -0,0 +1,13 @@
+int main() {
+    int x = 0;
+    int s = 0;
+    while (x != 20000) {
+        int y = 0;
+        while (y < 10000) {
+            s = s + x - y;
+            y = y + 1;
+        }
+        x = x + 1;
+    }
+    return s - (s / 256) * 256;
+}
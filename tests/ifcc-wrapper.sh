@@ -15,10 +15,12 @@
 
 # Warning: you have to forward the exit status of your compiler back to the harness
 
+# IFCC_FLAGS (facultatif) est passé au compilateur, par exemple IFCC_FLAGS=--frontend=rd
+
 DESTNAME=$1
 SOURCENAME=$2
 
-$(dirname $0)/../compiler/ifcc $SOURCENAME >$DESTNAME
+$(dirname $0)/../compiler/ifcc $IFCC_FLAGS $SOURCENAME >$DESTNAME
 retcode=$?
 
 # forward exit status of the compiler
@@ -0,0 +1,11 @@
+int main() {
+    int a = 0;
+    int r = 5;
+    if (a) {
+        r = 7;
+    }
+    if (r == 5) {
+        r = r + 1;
+    }
+    return r;
+}
@@ -0,0 +1,16 @@
+int f(int a, int b, int c, int d, int e, int g) {
+    int x1 = a + b; int x2 = b * c; int x3 = c - d; int x4 = d + e;
+    int x5 = e * g; int x6 = g - a; int x7 = a * a; int x8 = b + b;
+    int x9 = c * 3; int x10 = d - 7; int x11 = e + 11; int x12 = g * 2;
+    int y = x1 + x2 + x3 + x4 + x5 + x6 + x7 + x8 + x9 + x10 + x11 + x12;
+    int z = x1 * x12 - x2 * x11 + x3 * x10 - x4 * x9 + x5 * x8 - x6 * x7;
+    return (y + z) / 7;
+}
+
+int main() {
+    int r = f(1, 2, 3, 4, 5, 6);
+    int q = f(r, 1, r, 2, r, 3);
+    putchar(65 + r - (r / 26) * 26);
+    putchar(10);
+    return q - (q / 200) * 200;
+}
@@ -0,0 +1,23 @@
+int main() {
+    int a = 1 + 2 * 3;
+    int b = (a - 4) * (10 / 3);
+    int c = -a + !0 + !b;
+    int d = 0;
+    if (3 < 4) {
+        d = 5;
+    } else {
+        d = 6;
+    }
+    if (2 == 3) {
+        d = d + 100;
+    } else {
+        d = d + 1;
+    }
+    while (0 > 1) {
+        d = 0;
+    }
+    int e = a != b;
+    int f = 7 != 7;
+    int g = 9 > 2;
+    return a + b + c + d + e + f + g + (a * 8) / 4 - b * 5 + (-17) / 4 + 100 / -3;
+}
@@ -0,0 +1,18 @@
+int f(int a, int b, int c) {
+    int x = a * 4 + b;
+    int y = 8 + c * 2;
+    int z = x - 5 + (y - x) * 3;
+    int w = -z;
+    if (w) {
+        w = w / 7 + z / -2;
+    }
+    return x + y + z + w + !a + !(b - b);
+}
+
+int main() {
+    int r = f(3, 4, 5);
+    int s = f(-9, 2, 100);
+    putchar(48 + r - (r / 10) * 10);
+    putchar(10);
+    return s - (s / 50) * 50 + 60;
+}
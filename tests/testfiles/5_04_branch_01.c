@@ -0,0 +1,21 @@
+int main() {
+    int i = 0;
+    int n = 12;
+    int s = 0;
+    while (i < n) {
+        if (i != 3) {
+            s = s + i;
+        }
+        if (!(s == 10)) {
+            s = s + 1;
+        }
+        if (i > 8) {
+            s = s - 2;
+        }
+        i = i + 1;
+    }
+    int b = i != n;
+    int c = 5 > s;
+    int d = (s == 60) + (s != 60);
+    return s + b + c + d;
+}
@@ -0,0 +1,10 @@
+int main() {
+    int x = 1; int y = 2; int k = 0; int u;
+    int a = 0; int b = 1; int i = 0;
+    while (i < 10) { int t = a; a = b; b = t + b; i = i + 1; }
+    while (k < 5) { int t = x; x = y; y = t; if (k == 2) { u = x; } k = k + 1; }
+    int v;
+    if (x) { v = 3; } else { v = 4; }
+    putchar(48 + a / 10); putchar(10);
+    return x * 100 + y * 10 + v + u;
+}
@@ -0,0 +1,17 @@
+int f(int a, int b) {
+    int s = 0;
+    int i = 0;
+    int x = a * b + a * b;
+    while (i < 3) {
+        s = s + (x + 1) * (x + 1);
+        if (a * b > 10) {
+            s = s - (a * b);
+        }
+        i = i + 1;
+    }
+    return (s + (a != b) + (b != a) - (a - b) * (a - b)) / 3;
+}
+
+int main() {
+    return f(5, 7) - f(2, 3) * 2 + f(-1, 4);
+}
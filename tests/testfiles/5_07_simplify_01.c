@@ -0,0 +1,19 @@
+int main() {
+	int i = 0;
+	int s = 0;
+	int inutile = 3;
+	inutile = inutile * 7;
+	while (i < 10) {
+		if (i == 7) {
+			return s;
+			s = 100;
+		}
+		if (i == 2) {
+		} else {
+			s = s + i;
+		}
+		i = i + 1;
+	}
+	return 1;
+	return 2;
+}
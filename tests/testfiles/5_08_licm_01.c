@@ -0,0 +1,24 @@
+int main() {
+	int a = 9;
+	int b = 7;
+	int n = a - 9;
+	int i = 0;
+	int s = 0;
+	int j;
+	while (i < a * 2 + 1 - a) {
+		int k = a * b + 3;
+		int q = k / 4;
+		j = 0;
+		while (j < 5) {
+			s = s + k * 2 + q + (a == b);
+			if (n == 0) {
+				s = s + 1;
+			} else {
+				s = s + 100 / n;
+			}
+			j = j + 1;
+		}
+		i = i + 1;
+	}
+	return s - (s / 256) * 256;
+}
@@ -0,0 +1,22 @@
+int main() {
+    int n = 0;
+    int i = 5;
+    while (i < 3) {
+        n = n + 100;
+        i = i + 1;
+    }
+    int x = 0;
+    int s = 0;
+    while (x != 12) {
+        int y = 0;
+        while (y < x) {
+            s = s + x - y;
+            y = y + 1;
+        }
+        if (s > 50) {
+            n = n + 1;
+        }
+        x = x + 1;
+    }
+    return s - (s / 256) * 256 + n;
+}
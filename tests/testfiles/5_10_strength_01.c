@@ -0,0 +1,12 @@
+int main() {
+	int x = getchar() - 100;
+	int s = 0;
+	int i = 0;
+	while (i < 40) {
+		int v = x * 37 - i * 1000;
+		s = s + v / 8 + v / -4 + v / 7 + v / -10 + v / 1000;
+		s = s + v * 6 + v * 45 - v * 9 + v * -16;
+		i = i + 1;
+	}
+	return s - (s / 256) * 256;
+}
@@ -0,0 +1,15 @@
+int main() {
+	int a = getchar();
+	int b = 5;
+	int n = 0;
+	int c = !(a < b);
+	int d = (a == 3) == 0;
+	if (!(a < b)) {
+		c = c + 2;
+	}
+	while (!(n == b)) {
+		n = n + 1;
+		d = d + (n < 3);
+	}
+	return c * 10 + d;
+}
@@ -0,0 +1,27 @@
+int clamp(int v, int lo, int hi) {
+	if (v < lo) {
+		return lo;
+	}
+	if (v > hi) {
+		return hi;
+	}
+	return v;
+}
+int show(int c) {
+	putchar(48 + clamp(c, 0, 9));
+	return c;
+}
+int sum(int n) {
+	int s = 0;
+	int k = 0;
+	while (k < n) {
+		s = s + show(k);
+		k = k + 1;
+	}
+	return s;
+}
+int main() {
+	int r = sum(12) + sum(3);
+	putchar(10);
+	return r;
+}
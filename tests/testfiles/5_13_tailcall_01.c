@@ -0,0 +1,14 @@
+int sum(int n, int acc) {
+	if (n == 0) {
+		return acc;
+	}
+	return sum(n - 1, acc + n);
+}
+int show(int c) {
+	return putchar(c);
+}
+int main() {
+	int s = sum(5000, 0);
+	show(65 + s - (s / 26) * 26);
+	return s - (s / 256) * 256;
+}
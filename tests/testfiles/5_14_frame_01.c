@@ -0,0 +1,19 @@
+int mix(int a, int b, int c, int d, int e, int f, int g, int h, int i) {
+	return a - b + c * 2 - d + e - f + g * 3 - h + i * 5;
+}
+int leaf(int x, int y) {
+	int z = x * y;
+	return z - x;
+}
+int chain(int n, int a, int b, int c, int d, int e, int f, int g) {
+	if (n == 0) {
+		return a + b + c + d + e + f + g;
+	}
+	return chain(n - 1, g, a, b, c, d, e, f) + leaf(n, g);
+}
+int main() {
+	int r = mix(1, 2, 3, 4, 5, 6, 7, 8, 9);
+	r = r + chain(10, 1, 2, 3, 4, 5, 6, 7);
+	putchar(65 + r - (r / 26) * 26);
+	return r - (r / 256) * 256;
+}